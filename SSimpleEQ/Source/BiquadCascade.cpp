@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+
+void BiquadCascade::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    juce::ignoreUnused(spec);
+    reset();
+}
+
+void BiquadCascade::reset()
+{
+    for( auto& state : slotStates )
+        state = DSPKernels::SectionState();
+    
+    for( auto& state : states )
+        state = DSPKernels::SectionState();
+}
+
+void BiquadCascade::setKernels(const DSPKernels::KernelTable& newKernels)
+{
+    // the state layout is the same in every variant, so the running state carries straight over
+    kernels = &newKernels;
+    updateBlockSections();
+}
+
+void BiquadCascade::setCoefficients(const FilterCoefficientSet& coefficientSet)
+{
+    // the packed array is about to be rebuilt, park the running states in their slots first
+    storeSectionStates();
+    numActiveSections = 0;
+    
+    addCutSections(0, coefficientSet.lowCut, coefficientSet.lowCutSlope, coefficientSet.lowCutBypassed);
+    
+    if( ! coefficientSet.peakBypassed )
+        addSection(peakSlot, coefficientSet.peak);
+    
+    addCutSections(highCutSlot, coefficientSet.highCut, coefficientSet.highCutSlope, coefficientSet.highCutBypassed);
+    
+    // always kept up to date so switching modes doesn't have to wait for the next coefficient change
+    updateBlockSections();
+}
+
+void BiquadCascade::storeSectionStates()
+{
+    for( int i = 0; i < numActiveSections; ++i )
+        slotStates[sectionSlots[i]] = states[i];
+}
+
+void BiquadCascade::updateBlockSections()
+{
+    for( int i = 0; i < numActiveSections; ++i )
+        DSPKernels::makeBlockSection(blockSections[i], coefficients[i], kernels->numLanes);
+}
+
+void BiquadCascade::addSection(int slot, const BiquadCoefficients& c)
+{
+    coefficients[numActiveSections] = { (float)c[0], (float)c[1], (float)c[2], (float)c[3], (float)c[4] };
+    states[numActiveSections] = slotStates[slot];
+    
+    sectionSlots[numActiveSections] = slot;
+    ++numActiveSections;
+}
+
+void BiquadCascade::addCutSections(int firstSlot, const CutCoefficients& coefficients, Slope slope, bool bypassed)
+{
+    if( bypassed )
+        return;
+    
+    // same rule as updateCutFilter(): a slope of Slope_N uses stages 0...N
+    for( int stage = 0; stage <= slope; ++stage )
+        addSection(firstSlot + stage, coefficients[stage]);
+}
+
+void BiquadCascade::process(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    // a layout wider than this should have been turned down in isBusesLayoutSupported()
+    jassert((int)block.getNumChannels() <= maxChannels);
+    
+    processChannels(block, 0, juce::jmin((int)block.getNumChannels(), maxChannels));
+}
+
+void BiquadCascade::processChannels(const juce::dsp::AudioBlock<float>& block, int firstChannel, int numChannels) noexcept
+{
+    jassert(firstChannel % getChannelGroupSize() == 0);
+    jassert(firstChannel + numChannels <= juce::jmin((int)block.getNumChannels(), maxChannels));
+    
+    if( numActiveSections == 0 || numChannels <= 0 )
+        return;
+    
+    const auto numSamples = (int)block.getNumSamples();
+    
+    float* channels[maxChannels] = {};
+    for( int ch = 0; ch < numChannels; ++ch )
+        channels[ch] = block.getChannelPointer((size_t)(firstChannel + ch));
+    
+    if( mode == ProcessingMode::perSample )
+    {
+        /*
+         every combination of slopes and bypassed bands boils down to how many sections are packed,
+         e.g. both cuts at 12 dB/Oct with the peak on is the 3 section kernel.
+         */
+        kernels->perSample[numActiveSections](coefficients.data(), states.data(), firstChannel,
+                                               channels, numChannels, numSamples);
+        return;
+    }
+    
+    // the state space kernel runs one channel at a time, so pull that channel's lane out of the states
+    for( int i = 0; i < numChannels; ++i )
+    {
+        const auto ch = firstChannel + i;
+        float s1[numSlots], s2[numSlots];
+        
+        for( int k = 0; k < numActiveSections; ++k )
+        {
+            s1[k] = states[k].s1[ch];
+            s2[k] = states[k].s2[ch];
+        }
+        
+        kernels->blockStateSpace(blockSections.data(), numActiveSections, channels[i], numSamples, s1, s2);
+        
+        for( int k = 0; k < numActiveSections; ++k )
+        {
+            states[k].s1[ch] = s1[k];
+            states[k].s2[ch] = s2[k];
+        }
+    }
+}
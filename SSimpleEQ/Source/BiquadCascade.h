@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "DSPKernels.h"
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+/*
+ plain biquad coefficients { b0, b1, b2, a1, a2 }, already normalised by a0.
+ these live on the stack / in preallocated storage, without the heap allocations that the
+ juce::dsp::FilterDesign and IIR::Coefficients factories do. whole sets are designed on the
+ CoefficientDesigner thread and handed to the audio thread through a TripleBuffer.
+ they are designed in double, a low cut at 20 Hz and 192 kHz puts its poles so close to 1 that float
+ design maths is noticeably off. the float paths round them once when they load them.
+ */
+using BiquadCoefficients = std::array<double, 5>;
+using CutCoefficients = std::array<BiquadCoefficients, 4>;
+
+// everything the audio thread needs to configure the filters
+struct FilterCoefficientSet
+{
+    CutCoefficients lowCut {};
+    BiquadCoefficients peak {};
+    CutCoefficients highCut {};
+    
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+    bool lowCutBypassed {false}, peakBypassed {false}, highCutBypassed {false};
+};
+
+/*
+ processes every channel of the EQ in one pass.
+ the filter state is kept structure of arrays, so neighbouring channels sit in the lanes of one SIMD
+ register and every biquad runs once per sample for 4/8/16 channels at a time (depending on the
+ instruction set) instead of once per channel like the MonoChains did.
+ 
+ only the sections that are actually switched on are kept, packed into one contiguous, cache line
+ aligned array, and the whole cascade runs per sample. Each sample goes through every active
+ section while it sits in a register, instead of every stage making its own pass over the block.
+ 
+ the loops themselves come from DSPKernels, built for each instruction set and picked at runtime.
+ 
+ the layout matches MonoChain: 4 LowCut stages, the Peak, then 4 HighCut stages,
+ and a stage that is bypassed keeps its state untouched just like a bypassed ProcessorChain slot.
+ */
+struct BiquadCascade
+{
+    enum class ProcessingMode
+    {
+        perSample,          // channels in SIMD lanes, one sample at a time through the whole cascade
+        blockStateSpace     // per channel, one register's worth of samples per step using the block state space form
+    };
+    
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+    
+    // call on the audio thread whenever a new set has been swapped in
+    void setCoefficients(const FilterCoefficientSet& coefficientSet);
+    
+    // processes up to the first maxChannels channels of the block in place
+    void process(const juce::dsp::AudioBlock<float>& block) noexcept;
+    
+    /*
+     processes just channels firstChannel ... firstChannel + numChannels - 1 of the block.
+     firstChannel has to be a multiple of getChannelGroupSize(), that way ranges that don't overlap
+     never touch the same state and can be run on different threads at the same time.
+     */
+    void processChannels(const juce::dsp::AudioBlock<float>& block, int firstChannel, int numChannels) noexcept;
+    
+    // how many channels the kernels run side by side
+    int getChannelGroupSize() const noexcept { return kernels->numLanes; }
+    
+    // both modes share the same state, so this can be switched between any two blocks
+    void setProcessingMode(ProcessingMode newMode) noexcept { mode = newMode; }
+    ProcessingMode getProcessingMode() const noexcept { return mode; }
+    
+    // the instruction set specific loops, call this from prepareToPlay rather than the audio thread
+    void setKernels(const DSPKernels::KernelTable& newKernels);
+    DSPKernels::InstructionSet getInstructionSet() const noexcept { return kernels->instructionSet; }
+    
+    static constexpr int maxChannels = DSPKernels::maxChannels;
+    static constexpr int numCutStages = 4;
+    static constexpr int numSlots = numCutStages * 2 + 1;
+    static constexpr int peakSlot = numCutStages;
+    static constexpr int highCutSlot = numCutStages + 1;
+    
+    static_assert(numSlots <= DSPKernels::maxSections, "the kernels don't go up to this many sections");
+private:
+    // the active sections in processing order
+    alignas(64) std::array<DSPKernels::SectionCoefficients, numSlots> coefficients;
+    std::array<DSPKernels::SectionState, numSlots> states;
+    // which slot (LowCut 0-3, Peak, HighCut 0-3) each active section came from
+    std::array<int, numSlots> sectionSlots {};
+    int numActiveSections = 0;
+    
+    // the state of every slot while it isn't active, so it resumes where it left off
+    std::array<DSPKernels::SectionState, numSlots> slotStates;
+    
+    // the active sections again in block state space form, for however many lanes the kernels use
+    std::array<DSPKernels::BlockSection, numSlots> blockSections;
+    
+    const DSPKernels::KernelTable* kernels = DSPKernels::getGenericKernels();
+    ProcessingMode mode = ProcessingMode::perSample;
+    
+    void storeSectionStates();
+    void updateBlockSections();
+    void addSection(int slot, const BiquadCoefficients& c);
+    void addCutSections(int firstSlot, const CutCoefficients& coefficients, Slope slope, bool bypassed);
+};
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    ChannelWorkerPool.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include "ChannelWorkerPool.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+namespace
+{
+    // about a tenth of a millisecond of spinning, well under one block at any sensible block size
+    constexpr int spinIterations = 4000;
+
+    inline void pause() noexcept
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #elif JUCE_ARM && (defined(__GNUC__) || defined(__clang__))
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+}
+
+ChannelWorkerPool::Worker::Worker(ChannelWorkerPool& owner, int participantIndex) :
+juce::Thread("SSimpleEQ Channel Worker " + juce::String(participantIndex)),
+pool(owner),
+participant(participantIndex)
+{
+}
+
+void ChannelWorkerPool::Worker::run()
+{
+    auto lastBatch = pool.batch.load();
+
+    while( ! threadShouldExit() )
+    {
+        auto batchNumber = pool.waitForNextBatch(*this, lastBatch);
+
+        // woken up to exit
+        if( batchNumber == lastBatch )
+            continue;
+
+        lastBatch = batchNumber;
+        pool.processTasks(participant, batchNumber);
+    }
+}
+
+//==============================================================================
+ChannelWorkerPool::ChannelWorkerPool()
+{
+}
+
+ChannelWorkerPool::~ChannelWorkerPool()
+{
+    release();
+}
+
+void ChannelWorkerPool::prepare(int newNumWorkers)
+{
+    release();
+
+    numWorkers = juce::jlimit(0, maxWorkers, newNumWorkers);
+
+    for( int i = 0; i < numWorkers; ++i )
+    {
+        // participant 0 is the audio thread
+        workers[i] = std::make_unique<Worker>(*this, i + 1);
+        workers[i]->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+void ChannelWorkerPool::release()
+{
+    // stopThread() notifies, so parked workers wake up and see they should exit
+    for( auto& worker : workers )
+    {
+        if( worker != nullptr )
+            worker->stopThread(1000);
+
+        worker.reset();
+    }
+
+    numWorkers = 0;
+}
+
+void ChannelWorkerPool::runTasks(int numTasks, TaskFunction function, void* context) noexcept
+{
+    if( numTasks <= 0 )
+        return;
+
+    if( numWorkers == 0 || numTasks == 1 )
+    {
+        for( int i = 0; i < numTasks; ++i )
+            function(context, i);
+
+        return;
+    }
+
+    taskFunction = function;
+    taskContext = context;
+    remainingTasks.store(numTasks);
+
+    // 0 is what the workers start out having seen, so skip it when the counter wraps
+    auto batchNumber = batch.load() + 1;
+    if( batchNumber == 0 )
+        batchNumber = 1;
+
+    const auto numParticipants = numWorkers + 1;
+
+    for( int p = 0; p < numParticipants; ++p )
+    {
+        const auto begin = numTasks * p / numParticipants;
+        const auto end = numTasks * (p + 1) / numParticipants;
+
+        queues[p].end.store(end, std::memory_order_relaxed);
+        queues[p].next.store(((juce::uint64)batchNumber << 32) | (juce::uint32)begin, std::memory_order_release);
+    }
+
+    batch.store(batchNumber);
+
+    // only the ones that went to sleep need a wake up, the spinning ones see the new batch by themselves
+    for( int i = 0; i < numWorkers; ++i )
+    {
+        if( workers[i]->parked.load() )
+            workers[i]->notify();
+    }
+
+    processTasks(0, batchNumber);
+    waitForBatchToFinish();
+}
+
+void ChannelWorkerPool::processTasks(int participant, juce::uint32 batchNumber) noexcept
+{
+    const auto numParticipants = numWorkers + 1;
+
+    // our own run first, then steal from the others, starting with our neighbour
+    for( int i = 0; i < numParticipants; ++i )
+    {
+        auto& queue = queues[(participant + i) % numParticipants];
+        int index;
+
+        while( claimTask(queue, batchNumber, index) )
+        {
+            taskFunction(taskContext, index);
+
+            if( remainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1 && audioThreadParked.load() )
+                batchFinished.signal();
+        }
+    }
+}
+
+bool ChannelWorkerPool::claimTask(TaskQueue& queue, juce::uint32 batchNumber, int& index) noexcept
+{
+    auto next = queue.next.load(std::memory_order_acquire);
+
+    for( ;; )
+    {
+        if( (juce::uint32)(next >> 32) != batchNumber )
+            return false;
+
+        const auto candidate = (int)(juce::uint32)next;
+        if( candidate >= queue.end.load(std::memory_order_relaxed) )
+            return false;
+
+        if( queue.next.compare_exchange_weak(next, next + 1, std::memory_order_acq_rel, std::memory_order_acquire) )
+        {
+            index = candidate;
+            return true;
+        }
+    }
+}
+
+void ChannelWorkerPool::waitForBatchToFinish() noexcept
+{
+    for( int i = 0; i < spinIterations; ++i )
+    {
+        if( remainingTasks.load(std::memory_order_acquire) == 0 )
+            return;
+
+        pause();
+    }
+
+    // somebody is still busy with a whole task, stop burning the core and let them signal us
+    audioThreadParked.store(true);
+
+    while( remainingTasks.load(std::memory_order_acquire) != 0 )
+        batchFinished.wait(1);
+
+    audioThreadParked.store(false);
+}
+
+juce::uint32 ChannelWorkerPool::waitForNextBatch(Worker& worker, juce::uint32 lastBatch)
+{
+    for( int i = 0; i < spinIterations; ++i )
+    {
+        auto current = batch.load();
+        if( current != lastBatch )
+            return current;
+
+        pause();
+    }
+
+    /*
+     runTasks() bumps the batch before looking at parked, and we set parked before looking at the
+     batch again, so one of us always sees the other. a notify that lands before wait() isn't lost either.
+     */
+    worker.parked.store(true);
+
+    auto current = batch.load();
+    if( current == lastBatch && ! worker.threadShouldExit() )
+    {
+        worker.wait(-1);
+        current = batch.load();
+    }
+
+    worker.parked.store(false);
+    return current;
+}
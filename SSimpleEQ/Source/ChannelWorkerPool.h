@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    ChannelWorkerPool.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/*
+ a small pool of threads, started up front, that the audio thread can hand one block's worth of
+ independent tasks to (the channel groups of the filter cascade) and then help out with itself.
+
+ - the tasks are split into one contiguous run per participant, the audio thread included.
+   everybody works through their own run first, and once that is empty steals whatever is left
+   in the others. claiming a task is one compare and swap, nothing ever takes a lock.
+ - after a batch the workers spin for a little while before parking, so back to back blocks don't
+   pay for waking them up. the audio thread spins at the barrier at the end of the batch the same way.
+ */
+struct ChannelWorkerPool
+{
+    // plus the audio thread
+    static constexpr int maxWorkers = 7;
+
+    ChannelWorkerPool();
+    ~ChannelWorkerPool();
+
+    // (re)starts numWorkers threads, clamped to maxWorkers. call from prepareToPlay, not the audio thread
+    void prepare(int numWorkers);
+    void release();
+
+    int getNumWorkers() const noexcept { return numWorkers; }
+
+    /*
+     calls task(0) ... task(numTasks - 1) spread over the workers and the calling thread, and
+     returns once every one of them has finished. task has to be safe to call for different indices
+     at the same time. only ever call this from one thread (the audio thread).
+     */
+    template<typename Task>
+    void run(int numTasks, Task& task) noexcept
+    {
+        runTasks(numTasks, [](void* context, int index) { (*static_cast<Task*>(context))(index); }, &task);
+    }
+private:
+    using TaskFunction = void (*)(void* context, int index);
+
+    struct Worker : juce::Thread
+    {
+        Worker(ChannelWorkerPool& owner, int participantIndex);
+
+        void run() override;
+
+        ChannelWorkerPool& pool;
+        const int participant;
+        std::atomic<bool> parked { false };
+    };
+
+    /*
+     one participant's run of tasks. next packs the batch number into the top 32 bits, so a worker
+     still finishing off an old batch can never claim a task from the next one.
+     */
+    struct alignas(64) TaskQueue
+    {
+        std::atomic<juce::uint64> next { 0 };
+        std::atomic<int> end { 0 };
+    };
+
+    std::array<std::unique_ptr<Worker>, maxWorkers> workers;
+    int numWorkers = 0;
+
+    std::array<TaskQueue, maxWorkers + 1> queues;
+    std::atomic<juce::uint32> batch { 0 };
+
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+
+    alignas(64) std::atomic<int> remainingTasks { 0 };
+    std::atomic<bool> audioThreadParked { false };
+    juce::WaitableEvent batchFinished;
+
+    void runTasks(int numTasks, TaskFunction function, void* context) noexcept;
+    void processTasks(int participant, juce::uint32 batchNumber) noexcept;
+    bool claimTask(TaskQueue& queue, juce::uint32 batchNumber, int& index) noexcept;
+    void waitForBatchToFinish() noexcept;
+    juce::uint32 waitForNextBatch(Worker& worker, juce::uint32 lastBatch);
+};
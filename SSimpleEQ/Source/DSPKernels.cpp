@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    DSPKernels.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include "DSPKernels.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define SSIMPLEEQ_X86 1
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+  #include <immintrin.h>
+ #endif
+#else
+ #define SSIMPLEEQ_X86 0
+#endif
+
+namespace DSPKernels
+{
+namespace
+{
+    bool cpuSupports(InstructionSet instructionSet)
+    {
+       #if SSIMPLEEQ_X86
+        #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const auto maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] & (1 << 26)) != 0;
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+
+        bool avx2 = false, avx512f = false;
+        if( maxLeaf >= 7 )
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+            avx512f = (info[1] & (1 << 16)) != 0;
+        }
+
+        // the os has to save the wider registers too, not just the cpu have them
+        const auto xcr0 = osxsave ? _xgetbv(0) : 0;
+        const bool osSavesYmm = (xcr0 & 0x6) == 0x6;
+        const bool osSavesZmm = (xcr0 & 0xe6) == 0xe6;
+
+        switch( instructionSet )
+        {
+            case InstructionSet::generic: return true;
+            case InstructionSet::sse2:    return sse2;
+            case InstructionSet::avx2:    return avx && avx2 && fma && osSavesYmm;
+            case InstructionSet::avx512:  return avx512f && avx2 && fma && osSavesZmm;
+        }
+        #else
+        // these check the os support (xgetbv) as well
+        __builtin_cpu_init();
+
+        switch( instructionSet )
+        {
+            case InstructionSet::generic: return true;
+            case InstructionSet::sse2:    return __builtin_cpu_supports("sse2");
+            case InstructionSet::avx2:    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            case InstructionSet::avx512:  return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")
+                                                 && __builtin_cpu_supports("fma");
+        }
+        #endif
+       #endif
+
+        return instructionSet == InstructionSet::generic;
+    }
+
+    const KernelTable* getTable(InstructionSet instructionSet)
+    {
+        switch( instructionSet )
+        {
+            case InstructionSet::generic: return getGenericKernels();
+            case InstructionSet::sse2:    return getSSE2Kernels();
+            case InstructionSet::avx2:    return getAVX2Kernels();
+            case InstructionSet::avx512:  return getAVX512Kernels();
+        }
+
+        return nullptr;
+    }
+
+    InstructionSet stepDown(InstructionSet instructionSet)
+    {
+        switch( instructionSet )
+        {
+            case InstructionSet::avx512: return InstructionSet::avx2;
+            case InstructionSet::avx2:   return InstructionSet::sse2;
+            default:                     return InstructionSet::generic;
+        }
+    }
+
+    // -1 = nothing forced, otherwise an InstructionSet
+    std::atomic<int> forcedInstructionSet { -1 };
+
+    int readForcedInstructionSetFromEnvironment()
+    {
+        auto* value = std::getenv("SSIMPLEEQ_FORCE_ISA");
+        if( value == nullptr )
+            return -1;
+
+        for( auto instructionSet : { InstructionSet::generic, InstructionSet::sse2, InstructionSet::avx2, InstructionSet::avx512 } )
+        {
+            if( std::strcmp(value, getName(instructionSet)) == 0 )
+                return (int)instructionSet;
+        }
+
+        return -1;
+    }
+}
+
+const char* getName(InstructionSet instructionSet)
+{
+    switch( instructionSet )
+    {
+        case InstructionSet::generic: return "generic";
+        case InstructionSet::sse2:    return "sse2";
+        case InstructionSet::avx2:    return "avx2";
+        case InstructionSet::avx512:  return "avx512";
+    }
+
+    return "unknown";
+}
+
+bool isSupported(InstructionSet instructionSet)
+{
+    return getTable(instructionSet) != nullptr && cpuSupports(instructionSet);
+}
+
+InstructionSet getBestSupportedInstructionSet()
+{
+    static const auto best = []
+    {
+        auto instructionSet = InstructionSet::avx512;
+
+        while( ! isSupported(instructionSet) )
+            instructionSet = stepDown(instructionSet);
+
+        return instructionSet;
+    }();
+
+    return best;
+}
+
+const KernelTable& getKernels(InstructionSet instructionSet)
+{
+    // asking for more than the cpu can do gets the best it can do, never an illegal instruction
+    while( ! isSupported(instructionSet) )
+        instructionSet = stepDown(instructionSet);
+
+    return *getTable(instructionSet);
+}
+
+const KernelTable& getKernels()
+{
+    static const int forcedFromEnvironment = readForcedInstructionSetFromEnvironment();
+
+    auto forced = forcedInstructionSet.load();
+    if( forced < 0 )
+        forced = forcedFromEnvironment;
+
+    if( forced >= 0 )
+        return getKernels((InstructionSet)forced);
+
+    return getKernels(getBestSupportedInstructionSet());
+}
+
+void forceInstructionSet(InstructionSet instructionSet)
+{
+    forcedInstructionSet.store((int)instructionSet);
+}
+
+void clearForcedInstructionSet()
+{
+    forcedInstructionSet.store(-1);
+}
+
+//==============================================================================
+void makeBlockSection(BlockSection& block, const SectionCoefficients& c, int numLanes)
+{
+    // worked out in double, these are products of up to numLanes coefficients
+    const double b0 = c.b0, b1 = c.b1, b2 = c.b2, a1 = c.a1, a2 = c.a2;
+
+    // x[n+1] = A x[n] + B u[n],  y[n] = C x[n] + D u[n]  with C = { 1, 0 } and D = b0
+    const double A[2][2] = { { -a1, 1.0 }, { -a2, 0.0 } };
+    const double B[2] = { b1 - a1 * b0, b2 - a2 * b0 };
+
+    // powers[k] = A^k
+    double powers[maxLanes + 1][2][2];
+    powers[0][0][0] = 1.0; powers[0][0][1] = 0.0;
+    powers[0][1][0] = 0.0; powers[0][1][1] = 1.0;
+
+    for( int k = 0; k < numLanes; ++k )
+        for( int r = 0; r < 2; ++r )
+            for( int col = 0; col < 2; ++col )
+                powers[k + 1][r][col] = powers[k][r][0] * A[0][col] + powers[k][r][1] * A[1][col];
+
+    // impulse response h[0] = D, h[m] = C A^(m-1) B
+    double h[maxLanes];
+    h[0] = b0;
+    for( int m = 1; m < numLanes; ++m )
+        h[m] = powers[m - 1][0][0] * B[0] + powers[m - 1][0][1] * B[1];
+
+    std::memset(&block, 0, sizeof(block));
+
+    for( int k = 0; k < numLanes; ++k )
+    {
+        // output k sees the initial state through C A^k...
+        block.o1[k] = (float)powers[k][0][0];
+        block.o2[k] = (float)powers[k][0][1];
+
+        // ...and input j through h[k - j]
+        for( int j = 0; j <= k; ++j )
+            block.t[j][k] = (float)h[k - j];
+    }
+
+    // input j reaches the next state through A^(numLanes - 1 - j) B
+    for( int j = 0; j < numLanes; ++j )
+    {
+        const auto& P = powers[numLanes - 1 - j];
+        block.q1[j] = (float)(P[0][0] * B[0] + P[0][1] * B[1]);
+        block.q2[j] = (float)(P[1][0] * B[0] + P[1][1] * B[1]);
+    }
+
+    const auto& P = powers[numLanes];
+    block.p11 = (float)P[0][0];
+    block.p12 = (float)P[0][1];
+    block.p21 = (float)P[1][0];
+    block.p22 = (float)P[1][1];
+
+    block.c = c;
+}
+}
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    DSPKernels.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+/*
+ the hot loops of the filter cascade and the analyzer, built once per instruction set and picked at
+ runtime from the CPU we are actually running on, so one binary covers the whole fleet.
+
+ this header (and everything behind it) deliberately doesn't include JuceHeader.h: the variants are
+ compiled with different target options, and any inline JUCE/std code instantiated in those
+ translation units could otherwise end up being the copy the linker picks for everybody else.
+ */
+namespace DSPKernels
+{
+    enum class InstructionSet
+    {
+        generic,    // plain C++, whatever the compiler makes of it (this is what ARM builds use)
+        sse2,
+        avx2,       // AVX2 + FMA
+        avx512      // AVX-512F
+    };
+
+    const char* getName(InstructionSet instructionSet);
+
+    // the widest register any variant uses, storage shared between variants is sized for this
+    constexpr int maxLanes = 16;
+    constexpr int maxSections = 9;
+    
+    // 7.1.4 needs 12, 3rd order ambisonics 16, big immersive renders 64. Every variant's lane count divides this evenly.
+    constexpr int maxChannels = 64;
+
+    struct SectionCoefficients
+    {
+        float b0, b1, b2, a1, a2;
+    };
+
+    /*
+     one filter section's state for every channel (transposed direct form II), stored structure of arrays
+     so that numLanes neighbouring channels load straight into one register.
+     the layout doesn't depend on the variant, so the state carries over when the kernels are swapped.
+     */
+    struct alignas(64) SectionState
+    {
+        float s1[maxChannels] {};
+        float s2[maxChannels] {};
+    };
+
+    /*
+     a section rewritten as state space (x = { s1, s2 }) and unrolled over numLanes samples:
+        outputs    = o1 * s1 + o2 * s2 + sum_j( t[j] * input[j] )
+        next s1/s2 = p * { s1, s2 } + sum_j( q1/q2[j] * input[j] )
+     every lane of o1, o2 and t[j] is one output sample, so a whole step of outputs comes out of a
+     handful of vector multiply-adds instead of a chain of dependent per sample updates.
+     */
+    struct alignas(64) BlockSection
+    {
+        float o1[maxLanes], o2[maxLanes];
+        float t[maxLanes][maxLanes];
+        float q1[maxLanes], q2[maxLanes];
+        float p11, p12, p21, p22;
+
+        // plain coefficients for the samples left over at the end of a block
+        SectionCoefficients c;
+    };
+
+    // fills in the block form for a variant that runs numLanes samples per step
+    void makeBlockSection(BlockSection& block, const SectionCoefficients& c, int numLanes);
+
+    /*
+     runs every sample of numChannels channels through numSections sections, one channel per lane,
+     numLanes channels at a time. channels[0] uses the state of channel firstChannel, which has to be a
+     multiple of numLanes. the section count is baked into each entry of KernelTable::perSample.
+     */
+    using PerSampleKernel = void (*)(const SectionCoefficients* coefficients, SectionState* states, int firstChannel,
+                                     float* const* channels, int numChannels, int numSamples);
+
+    // runs one channel through the block state space form, s1/s2 hold that channel's state per section
+    using BlockStateSpaceKernel = void (*)(const BlockSection* sections, int numSections,
+                                           float* samples, int numSamples, float* s1, float* s2);
+
+    // dest[i] = source[i] * window[i]
+    using WindowKernel = void (*)(float* dest, const float* source, const float* window, int numSamples);
+
+    /*
+     the whole per frame analyzer post-processing in one pass over the bins. the interleaved { re, im } output
+     of a real-only FFT becomes dB = max(negativeInfinity, gainToDecibels(|bin| * scale)), through a fast log2
+     that's good to a couple of thousandths of a dB. then average[i] += smoothing * (dB - average[i]),
+     then peak[i] = max(average[i], peak[i] - peakDecay), and dest[i] gets that peak.
+     a huge peakDecay makes the peak simply follow the average.
+     dest can be complexBins itself, average and peak carry over from frame to frame.
+     */
+    using SpectrumKernel = void (*)(float* dest, float* average, float* peak, const float* complexBins, int numBins,
+                                    float scale, float negativeInfinity, float smoothing, float peakDecay);
+
+    /*
+     cos w - 1, sin w, cos 2w - 1 and sin 2w for every point of a frequency grid, w in radians per sample.
+     the cosines are kept as their distance from 1 (best worked out as -2 sin^2(w / 2)), which is what
+     keeps the response of a low cut accurate right down at the bottom of the grid.
+     */
+    struct ResponseGrid
+    {
+        const float* cos1MinusOne;
+        const float* sin1;
+        const float* cos2MinusOne;
+        const float* sin2;
+    };
+
+    /*
+     the frequency response of numSections sections in series at every point of the grid, numLanes points at a time.
+     decibels gets 20 log10 |H|. if phaseReal/phaseImag aren't null they get a vector pointing along the
+     response's phase (not its length, that's scaled to stay around 1), and if groupDelay isn't null it gets
+     the group delay in samples. every array has to have room for numPoints rounded up to a multiple of maxLanes.
+     */
+    using ResponseKernel = void (*)(const SectionCoefficients* sections, int numSections, const ResponseGrid& grid, int numPoints,
+                                    float* decibels, float* phaseReal, float* phaseImag, float* groupDelay);
+
+    struct KernelTable
+    {
+        InstructionSet instructionSet;
+        int numLanes;
+
+        // indexed by the number of active sections
+        std::array<PerSampleKernel, maxSections + 1> perSample;
+        BlockStateSpaceKernel blockStateSpace;
+
+        WindowKernel applyWindow;
+        SpectrumKernel processSpectrum;
+        ResponseKernel evaluateResponse;
+    };
+
+    // the best set the cpu supports, unless something was forced
+    const KernelTable& getKernels();
+    const KernelTable& getKernels(InstructionSet instructionSet);
+
+    InstructionSet getBestSupportedInstructionSet();
+    bool isSupported(InstructionSet instructionSet);
+
+    /*
+     for testing: makes getKernels() hand out a specific variant (clamped to what the cpu can run).
+     the SSIMPLEEQ_FORCE_ISA environment variable ("generic", "sse2", "avx2", "avx512") does the same
+     without recompiling. Processors pick this up the next time they are prepared.
+     */
+    void forceInstructionSet(InstructionSet instructionSet);
+    void clearForcedInstructionSet();
+
+    // the individual variants, the ones the build can't provide return nullptr
+    const KernelTable* getGenericKernels();
+    const KernelTable* getSSE2Kernels();
+    const KernelTable* getAVX2Kernels();
+    const KernelTable* getAVX512Kernels();
+}
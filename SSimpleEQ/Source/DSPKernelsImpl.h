@@ -0,0 +1,381 @@
+/*
+  ==============================================================================
+
+    DSPKernelsImpl.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+ the kernels themselves, written once against an "Ops" struct that wraps one instruction set:
+
+    Vec, numLanes
+    load / store (64 byte aligned), loadUnaligned / storeUnaligned, broadcast
+    add, sub, mul, div, max
+    mulAdd(a, b, c) = a * b + c,  negMulAdd(a, b, c) = c - a * b
+    sum(v)                          horizontal add
+    splitFloat(x, exponent, mantissa)  x = 2^exponent * mantissa, mantissa in [1, 2)
+    squaredMagnitudes(p)            re^2 + im^2 of numLanes interleaved complex values
+
+ only include this from the DSPKernels_*.cpp files, after their target options have been switched on,
+ and don't call anything from JUCE or the inline parts of the standard library in here (see DSPKernels.h
+ for why), memcpy is fine since it always ends up as the builtin or libc's own copy.
+ everything lives in an unnamed namespace so every variant gets its own private copy.
+ */
+namespace DSPKernels
+{
+namespace
+{
+    // the one lane version, used for the samples left over after the vector loops
+    struct ScalarOps
+    {
+        using Vec = float;
+        static constexpr int numLanes = 1;
+
+        static float broadcast(float x) { return x; }
+        static float sub(float a, float b) { return a - b; }
+        static float mulAdd(float a, float b, float c) { return a * b + c; }
+
+        static void splitFloat(float x, float& exponent, float& mantissa)
+        {
+            unsigned int bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+
+            exponent = (float)((int)((bits >> 23) & 0xff) - 127);
+
+            bits = (bits & 0x007fffffu) | 0x3f800000u;
+            std::memcpy(&mantissa, &bits, sizeof(bits));
+        }
+
+        static float squaredMagnitudes(const float* p) { return p[0] * p[0] + p[1] * p[1]; }
+    };
+
+    template<typename Ops, int NumSections>
+    void processChannelGroup(const SectionCoefficients* coefficients, SectionState* states, int firstChannel,
+                             float* const* channels, int numChannels, int numSamples)
+    {
+        using Vec = typename Ops::Vec;
+        constexpr int size = NumSections > 0 ? NumSections : 1;
+        
+        // with NumSections known the section loop unrolls and all of this stays in registers
+        Vec b0[size], b1[size], b2[size], a1[size], a2[size], s1[size], s2[size];
+        
+        for( int k = 0; k < NumSections; ++k )
+        {
+            b0[k] = Ops::broadcast(coefficients[k].b0);
+            b1[k] = Ops::broadcast(coefficients[k].b1);
+            b2[k] = Ops::broadcast(coefficients[k].b2);
+            a1[k] = Ops::broadcast(coefficients[k].a1);
+            a2[k] = Ops::broadcast(coefficients[k].a2);
+            s1[k] = Ops::load(states[k].s1 + firstChannel);
+            s2[k] = Ops::load(states[k].s2 + firstChannel);
+        }
+        
+        // lanes past the last channel stay at zero so they can't build up denormals or NaNs
+        alignas(64) float lanes[maxLanes] = {};
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            for( int ch = 0; ch < numChannels; ++ch )
+                lanes[ch] = channels[ch][i];
+            
+            auto x = Ops::load(lanes);
+            
+            for( int k = 0; k < NumSections; ++k )
+            {
+                auto y = Ops::mulAdd(b0[k], x, s1[k]);
+                s1[k] = Ops::mulAdd(b1[k], x, Ops::negMulAdd(a1[k], y, s2[k]));
+                s2[k] = Ops::negMulAdd(a2[k], y, Ops::mul(b2[k], x));
+                x = y;
+            }
+            
+            Ops::store(lanes, x);
+            
+            for( int ch = 0; ch < numChannels; ++ch )
+                channels[ch][i] = lanes[ch];
+        }
+        
+        for( int k = 0; k < NumSections; ++k )
+        {
+            Ops::store(states[k].s1 + firstChannel, s1[k]);
+            Ops::store(states[k].s2 + firstChannel, s2[k]);
+        }
+    }
+    
+    template<typename Ops, int NumSections>
+    void processPerSample(const SectionCoefficients* coefficients, SectionState* states, int firstChannel,
+                          float* const* channels, int numChannels, int numSamples)
+    {
+        // numLanes channels per pass, e.g. 7.1.4 is 3 passes with SSE2 and 2 with AVX2
+        for( int first = 0; first < numChannels; first += Ops::numLanes )
+        {
+            const auto groupSize = numChannels - first < Ops::numLanes ? numChannels - first : Ops::numLanes;
+            processChannelGroup<Ops, NumSections>(coefficients, states, firstChannel + first,
+                                                  channels + first, groupSize, numSamples);
+        }
+    }
+    
+    template<typename Ops>
+    void processBlockStateSpace(const BlockSection* sections, int numSections,
+                                float* samples, int numSamples, float* s1, float* s2)
+    {
+        constexpr int numLanes = Ops::numLanes;
+        alignas(64) float lanes[maxLanes];
+
+        int i = 0;
+        for( ; i + numLanes <= numSamples; i += numLanes )
+        {
+            auto u = Ops::loadUnaligned(samples + i);
+
+            for( int k = 0; k < numSections; ++k )
+            {
+                const auto& b = sections[k];
+                Ops::store(lanes, u);
+
+                auto y = Ops::mulAdd(Ops::load(b.o1), Ops::broadcast(s1[k]),
+                                     Ops::mul(Ops::load(b.o2), Ops::broadcast(s2[k])));
+
+                for( int j = 0; j < numLanes; ++j )
+                    y = Ops::mulAdd(Ops::load(b.t[j]), Ops::broadcast(lanes[j]), y);
+
+                auto next1 = b.p11 * s1[k] + b.p12 * s2[k] + Ops::sum(Ops::mul(Ops::load(b.q1), u));
+                auto next2 = b.p21 * s1[k] + b.p22 * s2[k] + Ops::sum(Ops::mul(Ops::load(b.q2), u));
+
+                s1[k] = next1;
+                s2[k] = next2;
+                u = y;
+            }
+
+            Ops::storeUnaligned(samples + i, u);
+        }
+
+        // whatever doesn't fill a whole step goes through the plain recursion, the state is the same
+        for( ; i < numSamples; ++i )
+        {
+            auto x = samples[i];
+
+            for( int k = 0; k < numSections; ++k )
+            {
+                const auto& c = sections[k].c;
+                auto y = c.b0 * x + s1[k];
+                s1[k] = c.b1 * x - c.a1 * y + s2[k];
+                s2[k] = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+
+            samples[i] = x;
+        }
+    }
+
+    template<typename Ops>
+    void applyWindow(float* dest, const float* source, const float* window, int numSamples)
+    {
+        constexpr int numLanes = Ops::numLanes;
+
+        int i = 0;
+        for( ; i + numLanes <= numSamples; i += numLanes )
+            Ops::storeUnaligned(dest + i, Ops::mul(Ops::loadUnaligned(source + i), Ops::loadUnaligned(window + i)));
+
+        for( ; i < numSamples; ++i )
+            dest[i] = source[i] * window[i];
+    }
+
+    /*
+     log2(x) from the exponent bits plus a 5th order polynomial for the mantissa,
+     within 3e-5 of the real thing (about 0.0002 dB once scaled)
+     */
+    template<typename Ops>
+    typename Ops::Vec fastLog2(typename Ops::Vec x)
+    {
+        typename Ops::Vec exponent, mantissa;
+        Ops::splitFloat(x, exponent, mantissa);
+
+        auto f = Ops::sub(mantissa, Ops::broadcast(1.f));
+        auto p = Ops::broadcast(0.0458789501f);
+        p = Ops::mulAdd(p, f, Ops::broadcast(-0.194408323f));
+        p = Ops::mulAdd(p, f, Ops::broadcast(0.415411186f));
+        p = Ops::mulAdd(p, f, Ops::broadcast(-0.708678912f));
+        p = Ops::mulAdd(p, f, Ops::broadcast(1.4418255f));
+
+        return Ops::mulAdd(p, f, exponent);
+    }
+
+    // see SpectrumKernel. dest may be complexBins itself: bin i only ever lands on a slot that has already been read.
+    // 20 log10(|z| * scale) = 10 log10(|z|^2 * scale^2) = 10 log10(2) * log2(|z|^2 * scale^2)
+    template<typename Ops>
+    void processSpectrum(float* dest, float* average, float* peak, const float* complexBins, int numBins,
+                         float scale, float negativeInfinity, float smoothing, float peakDecay)
+    {
+        constexpr int numLanes = Ops::numLanes;
+
+        const auto scaleSquared = Ops::broadcast(scale * scale);
+        const auto decibelsPerLog2 = Ops::broadcast(3.01029996f);
+        const auto floor = Ops::broadcast(negativeInfinity);
+        const auto smoothingVec = Ops::broadcast(smoothing);
+        const auto decay = Ops::broadcast(peakDecay);
+
+        int i = 0;
+        for( ; i + numLanes <= numBins; i += numLanes )
+        {
+            auto power = Ops::mul(Ops::squaredMagnitudes(complexBins + 2 * i), scaleSquared);
+            auto decibels = Ops::max(Ops::mul(fastLog2<Ops>(power), decibelsPerLog2), floor);
+
+            auto smoothed = Ops::loadUnaligned(average + i);
+            smoothed = Ops::mulAdd(smoothingVec, Ops::sub(decibels, smoothed), smoothed);
+            Ops::storeUnaligned(average + i, smoothed);
+
+            auto held = Ops::max(smoothed, Ops::sub(Ops::loadUnaligned(peak + i), decay));
+            Ops::storeUnaligned(peak + i, held);
+            Ops::storeUnaligned(dest + i, held);
+        }
+
+        for( ; i < numBins; ++i )
+        {
+            auto power = ScalarOps::squaredMagnitudes(complexBins + 2 * i) * scale * scale;
+            auto decibels = fastLog2<ScalarOps>(power) * 3.01029996f;
+            decibels = decibels > negativeInfinity ? decibels : negativeInfinity;
+
+            auto smoothed = average[i] + smoothing * (decibels - average[i]);
+            average[i] = smoothed;
+
+            auto decayed = peak[i] - peakDecay;
+            auto held = smoothed > decayed ? smoothed : decayed;
+            peak[i] = held;
+            dest[i] = held;
+        }
+    }
+
+    template<typename Ops>
+    void evaluateResponse(const SectionCoefficients* sections, int numSections, const ResponseGrid& grid, int numPoints,
+                          float* decibels, float* phaseReal, float* phaseImag, float* groupDelay)
+    {
+        using Vec = typename Ops::Vec;
+        constexpr int numLanes = Ops::numLanes;
+
+        const auto zero = Ops::broadcast(0.f);
+        const auto one = Ops::broadcast(1.f);
+        const auto two = Ops::broadcast(2.f);
+        const auto tiny = Ops::broadcast(1.0e-30f);
+        const auto decibelsPerLog2 = Ops::broadcast(3.01029996f);
+
+        const bool wantPhase = phaseReal != nullptr && phaseImag != nullptr;
+        const bool wantGroupDelay = groupDelay != nullptr;
+
+        // the arrays are padded, so the last few lanes just work on whatever is in the padding
+        for( int i = 0; i < numPoints; i += numLanes )
+        {
+            const auto c1 = Ops::loadUnaligned(grid.cos1MinusOne + i);
+            const auto s1 = Ops::loadUnaligned(grid.sin1 + i);
+            const auto c2 = Ops::loadUnaligned(grid.cos2MinusOne + i);
+            const auto s2 = Ops::loadUnaligned(grid.sin2 + i);
+
+            Vec level = zero, pr = one, pi = zero, delay = zero;
+
+            for( int k = 0; k < numSections; ++k )
+            {
+                const auto& section = sections[k];
+                const auto b1 = Ops::broadcast(section.b1);
+                const auto b2 = Ops::broadcast(section.b2);
+                const auto a1 = Ops::broadcast(section.a1);
+                const auto a2 = Ops::broadcast(section.a2);
+
+                /*
+                 N = b0 + b1 e^-jw + b2 e^-2jw, D = 1 + a1 e^-jw + a2 e^-2jw. the real parts go through the
+                 DC gain plus (cos - 1) terms, otherwise a cut filter's zeros near DC would cancel out
+                 most of float's precision
+                 */
+                const auto nr = Ops::mulAdd(b2, c2, Ops::mulAdd(b1, c1, Ops::broadcast(section.b0 + section.b1 + section.b2)));
+                const auto ni = Ops::sub(zero, Ops::mulAdd(b2, s2, Ops::mul(b1, s1)));
+                const auto dr = Ops::mulAdd(a2, c2, Ops::mulAdd(a1, c1, Ops::broadcast(1.f + section.a1 + section.a2)));
+                const auto di = Ops::sub(zero, Ops::mulAdd(a2, s2, Ops::mul(a1, s1)));
+
+                // |N|^2 and |D|^2 can be 0 on a zero or a pole that sits right on the grid
+                const auto nn = Ops::max(Ops::mulAdd(ni, ni, Ops::mul(nr, nr)), tiny);
+                const auto dd = Ops::max(Ops::mulAdd(di, di, Ops::mul(dr, dr)), tiny);
+
+                // adding up logs rather than multiplying gains, so 9 steep sections can't underflow
+                level = Ops::mulAdd(Ops::sub(fastLog2<Ops>(nn), fastLog2<Ops>(dd)), decibelsPerLog2, level);
+
+                if( wantPhase )
+                {
+                    // only the angle matters, so the product gets scaled back to around 1 every section
+                    const auto qr = Ops::mulAdd(ni, di, Ops::mul(nr, dr));
+                    const auto qi = Ops::negMulAdd(nr, di, Ops::mul(ni, dr));
+
+                    const auto newReal = Ops::negMulAdd(pi, qi, Ops::mul(pr, qr));
+                    const auto newImag = Ops::mulAdd(pi, qr, Ops::mul(pr, qi));
+
+                    const auto size = Ops::max(Ops::max(Ops::max(newReal, Ops::sub(zero, newReal)),
+                                                        Ops::max(newImag, Ops::sub(zero, newImag))), tiny);
+                    pr = Ops::div(newReal, size);
+                    pi = Ops::div(newImag, size);
+                }
+
+                if( wantGroupDelay )
+                {
+                    // each polynomial P adds Re(P' conj(P)) / |P|^2 samples, P' being sum k p_k e^-jkw
+                    const auto nr2 = Ops::mulAdd(Ops::mul(two, b2), c2, Ops::mulAdd(b1, c1, Ops::broadcast(section.b1 + 2.f * section.b2)));
+                    const auto ni2 = Ops::sub(zero, Ops::mulAdd(Ops::mul(two, b2), s2, Ops::mul(b1, s1)));
+                    const auto dr2 = Ops::mulAdd(Ops::mul(two, a2), c2, Ops::mulAdd(a1, c1, Ops::broadcast(section.a1 + 2.f * section.a2)));
+                    const auto di2 = Ops::sub(zero, Ops::mulAdd(Ops::mul(two, a2), s2, Ops::mul(a1, s1)));
+
+                    const auto numeratorDelay = Ops::div(Ops::mulAdd(ni2, ni, Ops::mul(nr2, nr)), nn);
+                    const auto denominatorDelay = Ops::div(Ops::mulAdd(di2, di, Ops::mul(dr2, dr)), dd);
+
+                    delay = Ops::add(delay, Ops::sub(numeratorDelay, denominatorDelay));
+                }
+            }
+
+            Ops::storeUnaligned(decibels + i, level);
+
+            if( wantPhase )
+            {
+                Ops::storeUnaligned(phaseReal + i, pr);
+                Ops::storeUnaligned(phaseImag + i, pi);
+            }
+
+            if( wantGroupDelay )
+                Ops::storeUnaligned(groupDelay + i, delay);
+        }
+    }
+
+    template<typename Ops>
+    constexpr std::array<PerSampleKernel, maxSections + 1> makePerSampleKernels()
+    {
+        return
+        {
+            &processPerSample<Ops, 0>,
+            &processPerSample<Ops, 1>,
+            &processPerSample<Ops, 2>,
+            &processPerSample<Ops, 3>,
+            &processPerSample<Ops, 4>,
+            &processPerSample<Ops, 5>,
+            &processPerSample<Ops, 6>,
+            &processPerSample<Ops, 7>,
+            &processPerSample<Ops, 8>,
+            &processPerSample<Ops, 9>
+        };
+    }
+
+    template<typename Ops>
+    constexpr KernelTable makeKernelTable(InstructionSet instructionSet)
+    {
+        static_assert(maxChannels % Ops::numLanes == 0, "channel groups have to line up with the state arrays");
+        
+        return
+        {
+            instructionSet,
+            Ops::numLanes,
+            makePerSampleKernels<Ops>(),
+            &processBlockStateSpace<Ops>,
+            &applyWindow<Ops>,
+            &processSpectrum<Ops>,
+            &evaluateResponse<Ops>
+        };
+    }
+}
+}
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    DSPKernels_AVX2.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include <cstring>
+#include "DSPKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define SSIMPLEEQ_AVX2_KERNELS 1
+#else
+ #define SSIMPLEEQ_AVX2_KERNELS 0
+#endif
+
+#if SSIMPLEEQ_AVX2_KERNELS
+
+#include <immintrin.h>
+
+// everything from here on may use AVX2 and FMA, regardless of what the rest of the project is built with.
+// none of it runs until DSPKernels has checked that the cpu supports it.
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("avx,avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("avx,avx2,fma")
+#endif
+
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels
+{
+namespace
+{
+    struct AVX2Ops
+    {
+        using Vec = __m256;
+        static constexpr int numLanes = 8;
+        
+        static Vec load(const float* p) { return _mm256_load_ps(p); }
+        static Vec loadUnaligned(const float* p) { return _mm256_loadu_ps(p); }
+        static void store(float* p, Vec a) { _mm256_store_ps(p, a); }
+        static void storeUnaligned(float* p, Vec a) { _mm256_storeu_ps(p, a); }
+        static Vec broadcast(float x) { return _mm256_set1_ps(x); }
+        
+        static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+        static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+        static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+        static Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+        static Vec mulAdd(Vec a, Vec b, Vec c) { return _mm256_fmadd_ps(a, b, c); }
+        static Vec negMulAdd(Vec a, Vec b, Vec c) { return _mm256_fnmadd_ps(a, b, c); }
+        
+        static float sum(Vec a)
+        {
+            auto t = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            t = _mm_add_ps(t, _mm_movehl_ps(t, t));
+            t = _mm_add_ss(t, _mm_shuffle_ps(t, t, 1));
+            return _mm_cvtss_f32(t);
+        }
+        
+        static void splitFloat(Vec x, Vec& exponent, Vec& mantissa)
+        {
+            auto bits = _mm256_castps_si256(x);
+            exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+            mantissa = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+                                                           _mm256_set1_epi32(0x3f800000)));
+        }
+        
+        static Vec squaredMagnitudes(const float* p)
+        {
+            auto a = _mm256_loadu_ps(p);
+            auto b = _mm256_loadu_ps(p + 8);
+            
+            // shuffle_ps works within each 128 bit half, giving bins 0 1 4 5 | 2 3 6 7
+            auto re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            auto im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            auto power = _mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im));
+            
+            // ...so put the 64 bit pairs back in order
+            return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(power), _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+    };
+    
+    constexpr KernelTable avx2Kernels = makeKernelTable<AVX2Ops>(InstructionSet::avx2);
+}
+}
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
+
+namespace DSPKernels
+{
+const KernelTable* getAVX2Kernels()
+{
+   #if SSIMPLEEQ_AVX2_KERNELS
+    return &avx2Kernels;
+   #else
+    return nullptr;
+   #endif
+}
+}
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    DSPKernels_AVX512.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include <cstring>
+#include "DSPKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define SSIMPLEEQ_AVX512_KERNELS 1
+#else
+ #define SSIMPLEEQ_AVX512_KERNELS 0
+#endif
+
+#if SSIMPLEEQ_AVX512_KERNELS
+
+// gcc's avx512fintrin.h starts its intrinsics from deliberately undefined vectors, which -Wmaybe-uninitialized
+// reports wherever they get inlined. the warnings point into the header, so they're turned off from the include on
+#if defined(__GNUC__) && ! defined(__clang__)
+ #pragma GCC diagnostic push
+ #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <immintrin.h>
+
+// everything from here on may use AVX-512F, regardless of what the rest of the project is built with.
+// none of it runs until DSPKernels has checked that the cpu supports it.
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("avx512f,avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("avx512f,avx2,fma")
+#endif
+
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels
+{
+namespace
+{
+    struct AVX512Ops
+    {
+        using Vec = __m512;
+        static constexpr int numLanes = 16;
+        
+        static Vec load(const float* p) { return _mm512_load_ps(p); }
+        static Vec loadUnaligned(const float* p) { return _mm512_loadu_ps(p); }
+        static void store(float* p, Vec a) { _mm512_store_ps(p, a); }
+        static void storeUnaligned(float* p, Vec a) { _mm512_storeu_ps(p, a); }
+        static Vec broadcast(float x) { return _mm512_set1_ps(x); }
+        
+        static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+        static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+        static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+        static Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm512_max_ps(a, b); }
+        static Vec mulAdd(Vec a, Vec b, Vec c) { return _mm512_fmadd_ps(a, b, c); }
+        static Vec negMulAdd(Vec a, Vec b, Vec c) { return _mm512_fnmadd_ps(a, b, c); }
+        static float sum(Vec a) { return _mm512_reduce_add_ps(a); }
+        
+        static void splitFloat(Vec x, Vec& exponent, Vec& mantissa)
+        {
+            auto bits = _mm512_castps_si512(x);
+            exponent = _mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(127)));
+            mantissa = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff)),
+                                                           _mm512_set1_epi32(0x3f800000)));
+        }
+        
+        static Vec squaredMagnitudes(const float* p)
+        {
+            const auto even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+            const auto odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+            
+            auto a = _mm512_loadu_ps(p);
+            auto b = _mm512_loadu_ps(p + 16);
+            auto re = _mm512_permutex2var_ps(a, even, b);
+            auto im = _mm512_permutex2var_ps(a, odd, b);
+            return _mm512_fmadd_ps(re, re, _mm512_mul_ps(im, im));
+        }
+    };
+    
+    constexpr KernelTable avx512Kernels = makeKernelTable<AVX512Ops>(InstructionSet::avx512);
+}
+}
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#if defined(__GNUC__) && ! defined(__clang__)
+ #pragma GCC diagnostic pop
+#endif
+
+#endif
+
+namespace DSPKernels
+{
+const KernelTable* getAVX512Kernels()
+{
+   #if SSIMPLEEQ_AVX512_KERNELS
+    return &avx512Kernels;
+   #else
+    return nullptr;
+   #endif
+}
+}
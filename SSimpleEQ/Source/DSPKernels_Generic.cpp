@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    DSPKernels_Generic.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include <cstring>
+#include "DSPKernels.h"
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels
+{
+namespace
+{
+    // four plain floats, left to the compiler's auto-vectoriser (NEON on ARM)
+    struct GenericOps
+    {
+        struct Vec { float v[4]; };
+        static constexpr int numLanes = 4;
+        
+        static Vec load(const float* p) { Vec r; for( int i = 0; i < 4; ++i ) r.v[i] = p[i]; return r; }
+        static Vec loadUnaligned(const float* p) { return load(p); }
+        static void store(float* p, Vec a) { for( int i = 0; i < 4; ++i ) p[i] = a.v[i]; }
+        static void storeUnaligned(float* p, Vec a) { store(p, a); }
+        static Vec broadcast(float x) { Vec r; for( int i = 0; i < 4; ++i ) r.v[i] = x; return r; }
+        
+        static Vec add(Vec a, Vec b) { for( int i = 0; i < 4; ++i ) a.v[i] += b.v[i]; return a; }
+        static Vec sub(Vec a, Vec b) { for( int i = 0; i < 4; ++i ) a.v[i] -= b.v[i]; return a; }
+        static Vec mul(Vec a, Vec b) { for( int i = 0; i < 4; ++i ) a.v[i] *= b.v[i]; return a; }
+        static Vec div(Vec a, Vec b) { for( int i = 0; i < 4; ++i ) a.v[i] /= b.v[i]; return a; }
+        static Vec max(Vec a, Vec b) { for( int i = 0; i < 4; ++i ) a.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return a; }
+        static Vec mulAdd(Vec a, Vec b, Vec c) { return add(mul(a, b), c); }
+        static Vec negMulAdd(Vec a, Vec b, Vec c) { return sub(c, mul(a, b)); }
+        static float sum(Vec a) { return (a.v[0] + a.v[1]) + (a.v[2] + a.v[3]); }
+        
+        static void splitFloat(Vec x, Vec& exponent, Vec& mantissa)
+        {
+            for( int i = 0; i < 4; ++i )
+                ScalarOps::splitFloat(x.v[i], exponent.v[i], mantissa.v[i]);
+        }
+        
+        static Vec squaredMagnitudes(const float* p)
+        {
+            Vec r;
+            for( int i = 0; i < 4; ++i )
+                r.v[i] = p[2 * i] * p[2 * i] + p[2 * i + 1] * p[2 * i + 1];
+            return r;
+        }
+    };
+    
+    constexpr KernelTable genericKernels = makeKernelTable<GenericOps>(InstructionSet::generic);
+}
+
+const KernelTable* getGenericKernels()
+{
+    return &genericKernels;
+}
+}
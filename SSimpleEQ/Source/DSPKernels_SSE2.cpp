@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    DSPKernels_SSE2.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include <cstring>
+#include "DSPKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define SSIMPLEEQ_SSE2_KERNELS 1
+#else
+ #define SSIMPLEEQ_SSE2_KERNELS 0
+#endif
+
+#if SSIMPLEEQ_SSE2_KERNELS
+
+#include <immintrin.h>
+
+// everything from here on may use SSE2, regardless of what the rest of the project is built with
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("sse2")
+#endif
+
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels
+{
+namespace
+{
+    struct SSE2Ops
+    {
+        using Vec = __m128;
+        static constexpr int numLanes = 4;
+        
+        static Vec load(const float* p) { return _mm_load_ps(p); }
+        static Vec loadUnaligned(const float* p) { return _mm_loadu_ps(p); }
+        static void store(float* p, Vec a) { _mm_store_ps(p, a); }
+        static void storeUnaligned(float* p, Vec a) { _mm_storeu_ps(p, a); }
+        static Vec broadcast(float x) { return _mm_set1_ps(x); }
+        
+        static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+        static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+        static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+        static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+        static Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+        static Vec mulAdd(Vec a, Vec b, Vec c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Vec negMulAdd(Vec a, Vec b, Vec c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+        
+        static float sum(Vec a)
+        {
+            auto t = _mm_add_ps(a, _mm_movehl_ps(a, a));
+            t = _mm_add_ss(t, _mm_shuffle_ps(t, t, 1));
+            return _mm_cvtss_f32(t);
+        }
+        
+        static void splitFloat(Vec x, Vec& exponent, Vec& mantissa)
+        {
+            auto bits = _mm_castps_si128(x);
+            exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+            mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                                                     _mm_set1_epi32(0x3f800000)));
+        }
+        
+        static Vec squaredMagnitudes(const float* p)
+        {
+            auto a = _mm_loadu_ps(p);
+            auto b = _mm_loadu_ps(p + 4);
+            auto re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            auto im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            return _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+        }
+    };
+    
+    constexpr KernelTable sse2Kernels = makeKernelTable<SSE2Ops>(InstructionSet::sse2);
+}
+}
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC pop_options
+#endif
+
+#endif
+
+namespace DSPKernels
+{
+const KernelTable* getSSE2Kernels()
+{
+   #if SSIMPLEEQ_SSE2_KERNELS
+    return &sse2Kernels;
+   #else
+    return nullptr;
+   #endif
+}
+}
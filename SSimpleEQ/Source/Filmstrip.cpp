@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    Filmstrip.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include "Filmstrip.h"
+
+void Filmstrip::prepare(int newWidth, int newHeight, float newScale, int numFrames)
+{
+    numFrames = juce::jmax(0, numFrames);
+
+    if( newWidth == width && newHeight == height && newScale == scale && numFrames == getNumFrames() )
+        return;
+
+    width = newWidth;
+    height = newHeight;
+    scale = newScale;
+
+    physicalWidth = juce::jmax(1, juce::roundToInt(width * scale));
+    physicalHeight = juce::jmax(1, juce::roundToInt(height * scale));
+
+    frames.clear();
+    frames.resize((size_t)numFrames);
+}
+
+void Filmstrip::clear()
+{
+    for( auto& frame : frames )
+        frame = juce::Image();
+}
+
+Filmstrip& FilmstripCache::get(const juce::String& name, int width, int height, float scale, int numFrames)
+{
+    auto entry = std::find_if(entries.begin(), entries.end(), [&](const Entry& e)
+    {
+        return e.name == name && e.width == width && e.height == height && e.scale == scale;
+    });
+
+    if( entry != entries.end() )
+    {
+        entries.splice(entries.begin(), entries, entry);
+    }
+    else
+    {
+        entries.push_front({ name, width, height, scale, {} });
+
+        if( entries.size() > maxFilmstrips )
+            entries.pop_back();
+    }
+
+    auto& filmstrip = entries.front().filmstrip;
+    filmstrip.prepare(width, height, scale, numFrames);
+    return filmstrip;
+}
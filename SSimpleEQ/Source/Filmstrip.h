@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    Filmstrip.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <list>
+
+/*
+ pre-rendered frames of a control at one size and one physical pixel scale, so painting the control is
+ just a blit. a frame is only rendered the first time it's needed, a knob that never goes past noon
+ never pays for the other half of its frames.
+ */
+struct Filmstrip
+{
+    // throws the frames away if the size, scale or number of frames changed, otherwise does nothing
+    void prepare(int newWidth, int newHeight, float newScale, int numFrames);
+
+    // throws the frames away, for when whatever they show has changed
+    void clear();
+
+    int getNumFrames() const { return (int)frames.size(); }
+
+    /*
+     blits frame 'index' with its top left corner at (x, y). if it hasn't been rendered yet,
+     drawFrame(graphics, index) renders it first, in logical coordinates with (0, 0) at the top left.
+     */
+    template<typename DrawFrame>
+    void draw(juce::Graphics& g, int x, int y, int index, DrawFrame&& drawFrame)
+    {
+        if( index < 0 || index >= getNumFrames() || width <= 0 || height <= 0 )
+            return;
+
+        auto& frame = frames[(size_t)index];
+
+        if( ! frame.isValid() )
+        {
+            frame = juce::Image(juce::Image::PixelFormat::ARGB, physicalWidth, physicalHeight, true);
+
+            juce::Graphics frameGraphics(frame);
+            frameGraphics.addTransform(juce::AffineTransform::scale(scale));
+            drawFrame(frameGraphics, index);
+        }
+
+        g.drawImage(frame, x, y, width, height, 0, 0, physicalWidth, physicalHeight);
+    }
+private:
+    int width = 0, height = 0;
+    int physicalWidth = 0, physicalHeight = 0;
+    float scale = 1.f;
+
+    // an invalid image is a frame that hasn't been rendered yet
+    std::vector<juce::Image> frames;
+};
+
+/*
+ filmstrips shared by every control that looks the same, so seven knobs of one size render each frame
+ once between them. only the most recently used few are kept, resizing the editor doesn't pile them up.
+ */
+struct FilmstripCache
+{
+    // the filmstrip called 'name' at this size and scale, prepared for numFrames frames
+    Filmstrip& get(const juce::String& name, int width, int height, float scale, int numFrames);
+private:
+    static constexpr size_t maxFilmstrips = 16;
+
+    struct Entry
+    {
+        juce::String name;
+        int width, height;
+        float scale;
+        Filmstrip filmstrip;
+    };
+
+    // most recently used at the front
+    std::list<Entry> entries;
+};
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include "FrequencyResponse.h"
+
+void FrequencyResponseEvaluator::setFrequencies(const double* frequencies, int newNumFrequencies, double newSampleRate)
+{
+    numFrequencies = juce::jmax(0, newNumFrequencies);
+    sampleRate = newSampleRate;
+
+    constexpr auto lanes = DSPKernels::maxLanes;
+    const auto paddedSize = (size_t)((numFrequencies + lanes - 1) / lanes * lanes);
+
+    // the padding is w = 0, which keeps it well away from NaNs
+    for( auto* table : { &cos1MinusOne, &sin1, &cos2MinusOne, &sin2 } )
+        table->assign(paddedSize, 0.f);
+
+    for( auto* output : { &decibels, &phaseReal, &phaseImag, &phaseAngle, &groupDelayTime } )
+        output->assign(paddedSize, 0.f);
+
+    for( int i = 0; i < numFrequencies; ++i )
+    {
+        const auto w = juce::MathConstants<double>::twoPi * frequencies[i] / sampleRate;
+
+        // cos x - 1 = -2 sin^2(x / 2), without losing everything to cancellation when x is small
+        const auto halfSin = std::sin(0.5 * w);
+
+        cos1MinusOne[(size_t)i] = (float)(-2.0 * halfSin * halfSin);
+        sin1[(size_t)i] = (float)std::sin(w);
+        cos2MinusOne[(size_t)i] = (float)(-2.0 * std::sin(w) * std::sin(w));
+        sin2[(size_t)i] = (float)std::sin(2.0 * w);
+    }
+}
+
+void FrequencyResponseEvaluator::evaluate(const DSPKernels::SectionCoefficients* sections, int numSections, int outputs)
+{
+    const auto wantPhase = (outputs & phase) != 0;
+    const auto wantGroupDelay = (outputs & groupDelay) != 0;
+
+    DSPKernels::ResponseGrid grid { cos1MinusOne.data(), sin1.data(), cos2MinusOne.data(), sin2.data() };
+
+    kernels->evaluateResponse(sections, numSections, grid, numFrequencies,
+                              decibels.data(),
+                              wantPhase ? phaseReal.data() : nullptr,
+                              wantPhase ? phaseImag.data() : nullptr,
+                              wantGroupDelay ? groupDelayTime.data() : nullptr);
+
+    // the kernel leaves the phase as a direction, the angle is one atan2 per point
+    if( wantPhase )
+    {
+        for( int i = 0; i < numFrequencies; ++i )
+            phaseAngle[(size_t)i] = std::atan2(phaseImag[(size_t)i], phaseReal[(size_t)i]);
+    }
+
+    // samples to seconds
+    if( wantGroupDelay )
+        juce::FloatVectorOperations::multiply(groupDelayTime.data(), (float)(1.0 / sampleRate), numFrequencies);
+}
+
+DSPKernels::SectionCoefficients makeSection(const juce::dsp::IIR::Coefficients<float>& coefficients)
+{
+    const auto* c = coefficients.getRawCoefficients();
+
+    // juce keeps b0 b1 b2 a1 a2 for a biquad and b0 b1 a1 for a first order filter, a0 already divided out
+    if( coefficients.coefficients.size() == 3 )
+        return { c[0], c[1], 0.f, c[2], 0.f };
+
+    jassert( coefficients.coefficients.size() == 5 );
+    return { c[0], c[1], c[2], c[3], c[4] };
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPKernels.h"
+
+/*
+ the response of a cascade of biquads over a fixed grid of frequencies, the whole grid at once.
+
+ all the trig happens in setFrequencies(), which only needs calling again when the frequencies or the
+ sample rate change. after that evaluate() is only multiplies and adds, numLanes frequencies at a time
+ (DSPKernels::ResponseKernel). magnitude always comes out, phase and group delay only when asked for.
+ */
+struct FrequencyResponseEvaluator
+{
+    enum Outputs
+    {
+        magnitude = 0,
+        phase = 1 << 0,
+        groupDelay = 1 << 1
+    };
+
+    void setFrequencies(const double* frequencies, int numFrequencies, double sampleRate);
+
+    int getNumFrequencies() const { return numFrequencies; }
+    double getSampleRate() const { return sampleRate; }
+
+    // sections in series, with a0 divided out. 'outputs' is any of phase | groupDelay on top of the magnitude
+    void evaluate(const DSPKernels::SectionCoefficients* sections, int numSections, int outputs = magnitude);
+
+    // 20 log10 |H|
+    const float* getDecibels() const { return decibels.data(); }
+
+    // radians, between -pi and pi. only valid after an evaluate() that asked for it
+    const float* getPhase() const { return phaseAngle.data(); }
+
+    // seconds. only valid after an evaluate() that asked for it
+    const float* getGroupDelay() const { return groupDelayTime.data(); }
+private:
+    int numFrequencies = 0;
+    double sampleRate = 44100.0;
+
+    // everything is padded to a whole number of maxLanes, the kernels run straight over the padding
+    std::vector<float> cos1MinusOne, sin1, cos2MinusOne, sin2;
+    std::vector<float> decibels, phaseReal, phaseImag, phaseAngle, groupDelayTime;
+
+    const DSPKernels::KernelTable* kernels = &DSPKernels::getKernels();
+};
+
+// a juce IIR filter's coefficients as a section. a first order filter gets zeros for the terms it doesn't have
+DSPKernels::SectionCoefficients makeSection(const juce::dsp::IIR::Coefficients<float>& coefficients);
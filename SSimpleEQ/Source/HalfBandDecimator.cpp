@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.cpp
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#include "HalfBandDecimator.h"
+
+HalfBandDecimator::HalfBandDecimator()
+{
+    using namespace juce;
+
+    // the ideal half-band response, sin(pi k / 2) / (pi k), under a blackman window
+    std::array<double, numPairs> taps;
+    double sum = 0.0;
+
+    for( int i = 0; i < numPairs; ++i )
+    {
+        const auto n = 2 * i;
+        const auto k = n - centreTap;
+
+        const auto phase = MathConstants<double>::twoPi * n / (numTaps - 1);
+        const auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+        taps[i] = std::sin(MathConstants<double>::halfPi * k) / (MathConstants<double>::pi * k) * window;
+        sum += 2.0 * taps[i];
+    }
+
+    // the pairs have to come to a half between them, so with the centre tap DC goes through at exactly 1
+    for( int i = 0; i < numPairs; ++i )
+        coefficients[i] = (float)(taps[i] * 0.5 / sum);
+
+    reset();
+}
+
+void HalfBandDecimator::reset()
+{
+    history.fill(0.f);
+    position = 0;
+    outputDue = false;
+}
+
+int HalfBandDecimator::process(const float* input, int numSamples, float* output) noexcept
+{
+    int numOutputs = 0;
+
+    for( int i = 0; i < numSamples; ++i )
+    {
+        position = position + 1 == numTaps ? 0 : position + 1;
+        history[position] = history[position + numTaps] = input[i];
+
+        outputDue = ! outputDue;
+        if( ! outputDue )
+            continue;
+
+        // w[0] is the oldest of the last numTaps inputs, w[numTaps - 1] the one that just came in
+        const auto* w = history.data() + position + 1;
+
+        auto y = 0.5f * w[centreTap];
+
+        for( int k = 0; k < numPairs; ++k )
+            y += coefficients[k] * (w[2 * k] + w[numTaps - 1 - 2 * k]);
+
+        output[numOutputs++] = y;
+    }
+
+    return numOutputs;
+}
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.h
+    Created: 17 Oct 2026
+    Author:  YellowFever
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/*
+ halves the sample rate: a 31 tap half-band lowpass, then every other sample dropped.
+
+ it's done polyphase, so only the samples that are kept ever get filtered. every other tap of a
+ half-band filter is zero apart from the middle one, which is exactly a half, so each output is
+ 8 multiplies of symmetric pairs plus the centre tap. flat to about 0.16 of the input rate, and
+ everything from 0.34 up (the part that would fold back onto that) is down by 70 dB or more.
+ */
+struct HalfBandDecimator
+{
+    HalfBandDecimator();
+
+    void reset();
+
+    /*
+     feeds numSamples in and writes an output for every second one, returns how many outputs that was.
+     the phase carries over between calls, so blocks can be any size. output can be input itself,
+     it never gets ahead of what has been read.
+     */
+    int process(const float* input, int numSamples, float* output) noexcept;
+private:
+    static constexpr int numTaps = 31;
+    static constexpr int centreTap = numTaps / 2;
+
+    // taps 0, 2, ... 14, each of which is the same as its mirror image 30, 28, ... 16
+    static constexpr int numPairs = (centreTap + 1) / 2;
+
+    std::array<float, numPairs> coefficients;
+
+    // the last numTaps inputs, written twice over so they can always be read as one run
+    std::array<float, numTaps * 2> history;
+    int position = 0;
+    bool outputDue = false;
+};
@@ -9,34 +9,27 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
-void LookAndFeel::drawRotarySlider(juce::Graphics & g,
-                                   int x,
-                                   int y,
-                                   int width,
-                                   int height,
-                                   float sliderPosProportional,
-                                   float rotaryStartAngle,
-                                   float rotaryEndAngle,
-                                   juce::Slider & slider)
+namespace
 {
-    using namespace juce;
-    
-    auto bounds = Rectangle<float>(x, y, width, height);
-    
-    auto enabled = slider.isEnabled();
-    
-    // creating the bg for slider
-    g.setColour(enabled ? Colour(97u, 18u, 167u) : Colours::darkgrey);
-    g.fillEllipse(bounds);
-    
-    // creating the border for slider
-    g.setColour(enabled ? Colour(255u, 154u, 1u) : Colours::grey);
-    g.drawEllipse(bounds, 1.f);
-    
+    // the knob's body, filled and outlined
+    void drawKnobBody(juce::Graphics& g, juce::Rectangle<float> bounds, bool enabled)
+    {
+        using namespace juce;
+        
+        // creating the bg for slider
+        g.setColour(enabled ? Colour(97u, 18u, 167u) : Colours::darkgrey);
+        g.fillEllipse(bounds);
+        
+        // creating the border for slider
+        g.setColour(enabled ? Colour(255u, 154u, 1u) : Colours::grey);
+        g.drawEllipse(bounds, 1.f);
+    }
     
-    if(auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
+    // drawing the marker inside the slider and rotating it, in the border's colour
+    void drawKnobMarker(juce::Graphics& g, juce::Rectangle<float> bounds, float sliderAngRad, int textHeight)
     {
-        // drawing the marker inside the slider and rotating it
+        using namespace juce;
+        
         auto center = bounds.getCentre();
         
         Path p; // needed to make anything move
@@ -45,53 +38,21 @@ void LookAndFeel::drawRotarySlider(juce::Graphics & g,
         r.setLeft(center.getX() - 2);
         r.setRight(center.getX() + 2);
         r.setTop(bounds.getY());
-        r.setBottom(center.getY() - rswl->getTextHeight() * 1.5); // inner rectangle marker not starting from exact center. Saving space for text
+        r.setBottom(center.getY() - textHeight * 1.5); // inner rectangle marker not starting from exact center. Saving space for text
         
         p.addRoundedRectangle(r, 2.f); // change from addRectangle to addRoundedRectangle
         
-        jassert(rotaryStartAngle < rotaryEndAngle);
-        
-        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
-        
-        // rotating the narrow rectangle acc to the above radian angle - sliderAngRad
+        // rotating the narrow rectangle acc to the radian angle - sliderAngRad
         p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
         
         g.fillPath(p);
-        
-        g.setFont(rswl->getTextHeight()); // uses the default and gives height
-        auto text = rswl->getDisplayString();
-        auto strWidth = g.getCurrentFont().getStringWidth(text);
-        
-        // changing the same rectangle now to use with text
-        r.setSize(strWidth + 4, rswl->getTextHeight() + 2);
-        
-        // setting the center of this rectangle to the center of bounding box
-        r.setCentre(bounds.getCentre());
-        
-        // making the text background black
-        g.setColour(enabled ? Colours::black : Colours::darkgrey);
-        g.fillRect(r);
-        
-        // adding text making the text white
-        g.setColour(enabled ? Colours::white : Colours::lightgrey);
-        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1); // accepts Rectangle<int> as 2nd argument
-        
     }
-}
-
-void LookAndFeel::drawToggleButton(juce::Graphics &g,
-                                   juce::ToggleButton &toggleButton,
-                                   bool shouldDrawButtonAsHighlighted,
-                                   bool shouldDrawButtonAsDown)
-{
-    using namespace juce;
-    
     
-    if( auto* pb = dynamic_cast<PowerButton*>(&toggleButton))
+    void drawPowerButton(juce::Graphics& g, juce::Rectangle<int> bounds, bool toggleState)
     {
-        Path powerButton;
+        using namespace juce;
         
-        auto bounds = toggleButton.getLocalBounds();
+        Path powerButton;
         
     // see the bounding box region for bypass buttons
     //    g.setColour(Colours::red);
@@ -118,7 +79,7 @@ void LookAndFeel::drawToggleButton(juce::Graphics &g,
         
         PathStrokeType pst(2, PathStrokeType::JointStyle::curved);
         
-        auto color = toggleButton.getToggleState() ? juce::Colours::dimgrey : juce::Colour(0u, 172u, 1u);
+        auto color = toggleState ? juce::Colours::dimgrey : juce::Colour(0u, 172u, 1u);
         g.setColour(color);
         
         g.strokePath(powerButton, pst);
@@ -126,28 +87,122 @@ void LookAndFeel::drawToggleButton(juce::Graphics &g,
         // draw circle around the whole thing
         g.drawEllipse(r, 2);
     }
-    else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton))
+}
+
+void LookAndFeel::drawRotarySlider(juce::Graphics & g,
+                                   int x,
+                                   int y,
+                                   int width,
+                                   int height,
+                                   float sliderPosProportional,
+                                   float rotaryStartAngle,
+                                   float rotaryEndAngle,
+                                   juce::Slider & slider)
+{
+    using namespace juce;
+    
+    auto bounds = Rectangle<float>(x, y, width, height);
+    
+    auto enabled = slider.isEnabled();
+    
+    if(auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
     {
-        auto color = ! toggleButton.getToggleState() ? juce::Colours::dimgrey : juce::Colour(0u, 172u, 1u);
+        jassert(rotaryStartAngle < rotaryEndAngle);
         
-        g.setColour(color);
+        auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        
+        // enough frames that the marker's tip moves about two physical pixels from one to the next
+        auto radius = jmin(width, height) * 0.5f * scale;
+        auto numFrames = jlimit(32, 128, roundToInt((rotaryEndAngle - rotaryStartAngle) * radius * 0.5f));
+        
+        // every RotarySliderWithLabels has the same angles and text height, so only the size tells them apart.
+        // the frames have a pixel of margin all round for the border's stroke
+        auto& filmstrip = filmstrips->get(enabled ? "knob" : "knob disabled", width + 2, height + 2, scale, numFrames);
+        auto textHeight = rswl->getTextHeight();
+        
+        filmstrip.draw(g, x - 1, y - 1, roundToInt(sliderPosProportional * (numFrames - 1)), [&](Graphics& fg, int frame)
+        {
+            auto frameBounds = Rectangle<float>(1.f, 1.f, width, height);
+            auto sliderAngRad = jmap((float)frame / (float)(numFrames - 1), rotaryStartAngle, rotaryEndAngle);
+            
+            drawKnobBody(fg, frameBounds, enabled);
+            drawKnobMarker(fg, frameBounds, sliderAngRad, textHeight);
+        });
+        
+        g.setFont(textHeight); // uses the default and gives height
+        auto text = rswl->getDisplayString();
+        auto strWidth = g.getCurrentFont().getStringWidth(text);
+        
+        // a rectangle for the text
+        Rectangle<float> r;
+        r.setSize(strWidth + 4, textHeight + 2);
+        
+        // setting the center of this rectangle to the center of bounding box
+        r.setCentre(bounds.getCentre());
+        
+        // making the text background black
+        g.setColour(enabled ? Colours::black : Colours::darkgrey);
+        g.fillRect(r);
+        
+        // adding text making the text white
+        g.setColour(enabled ? Colours::white : Colours::lightgrey);
+        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1); // accepts Rectangle<int> as 2nd argument
+        
+    }
+    else
+    {
+        drawKnobBody(g, bounds, enabled);
+    }
+}
+
+void LookAndFeel::drawToggleButton(juce::Graphics &g,
+                                   juce::ToggleButton &toggleButton,
+                                   bool shouldDrawButtonAsHighlighted,
+                                   bool shouldDrawButtonAsDown)
+{
+    using namespace juce;
+    
+    auto bounds = toggleButton.getLocalBounds();
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    
+    // frame 0 is off, frame 1 is on
+    auto frame = toggleButton.getToggleState() ? 1 : 0;
+    
+    if( auto* pb = dynamic_cast<PowerButton*>(&toggleButton))
+    {
+        auto& filmstrip = filmstrips->get("power", bounds.getWidth(), bounds.getHeight(), scale, 2);
         
-        auto bounds = toggleButton.getLocalBounds();
-        g.drawRect(bounds);
+        filmstrip.draw(g, 0, 0, frame, [bounds](Graphics& fg, int toggleState)
+        {
+            drawPowerButton(fg, bounds, toggleState == 1);
+        });
+    }
+    else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton))
+    {
+        analyzerButton->filmstrip.prepare(bounds.getWidth(), bounds.getHeight(), scale, 2);
         
-//        auto insetRect = bounds.reduced(4); // container for random path representing a waveform icon
+        analyzerButton->filmstrip.draw(g, 0, 0, frame, [bounds, analyzerButton](Graphics& fg, int toggleState)
+        {
+            auto color = toggleState == 0 ? juce::Colours::dimgrey : juce::Colour(0u, 172u, 1u);
+            
+            fg.setColour(color);
+            
+            fg.drawRect(bounds);
+            
+//            auto insetRect = bounds.reduced(4); // container for random path representing a waveform icon
 //
-//        Path randomPath;
+//            Path randomPath;
 //
-//        Random r;
+//            Random r;
 //
-//        randomPath.startNewSubPath(insetRect.getX(), insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+//            randomPath.startNewSubPath(insetRect.getX(), insetRect.getY() + insetRect.getHeight() * r.nextFloat());
 //
-//        for ( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x+=2) {
-//            randomPath.lineTo(x, insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-//        }
-        
-        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
+//            for ( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x+=2) {
+//                randomPath.lineTo(x, insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+//            }
+            
+            fg.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
+        });
     }
 }
 
@@ -179,33 +234,46 @@ void RotarySliderWithLabels::paint(juce::Graphics &g)
                                       endAng,
                                       *this);
     
-    auto center = sliderBounds.toFloat().getCentre();
-    auto radius = sliderBounds.getWidth() * 0.5f;
+    labelRing.prepare(getWidth(), getHeight(), g.getInternalContext().getPhysicalPixelScaleFactor(), 1);
     
-    g.setColour(Colour(0u, 172u, 1u));
-    g.setFont(getTextHeight());
-    
-    auto numChoices = labels.size(); // get the array of labels, iterate through them
-    for( int i = 0; i < numChoices; ++i )
+    labelRing.draw(g, 0, 0, 0, [&](Graphics& lg, int)
     {
-        auto pos = labels[i].pos;
-        jassert(0.f <= pos);
-        jassert(pos <= 1.f);
-        
-        auto ang = jmap(pos, 0.f, 1.f, startAng, endAng);
+        auto center = sliderBounds.toFloat().getCentre();
+        auto radius = sliderBounds.getWidth() * 0.5f;
         
-        auto  c = center.getPointOnCircumference(radius + getTextHeight() * 0.5f + 1, ang); // getting the point where the text will be placed
+        lg.setColour(Colour(0u, 172u, 1u));
+        lg.setFont(getTextHeight());
         
-        // drawing a rectangle for the text and positioning it at point c
-        Rectangle<float> r;
-        auto str = labels[i].label;
-        r.setSize(g.getCurrentFont().getStringWidth(str), getTextHeight());
-        r.setCentre(c);
-        r.setY(r.getY() + getTextHeight());
-        
-        // drawing the text inside that rectangle
-        g.drawFittedText(str, r.toNearestInt(), juce::Justification::centred, 1);
-    }
+        auto numChoices = labels.size(); // get the array of labels, iterate through them
+        for( int i = 0; i < numChoices; ++i )
+        {
+            auto pos = labels[i].pos;
+            jassert(0.f <= pos);
+            jassert(pos <= 1.f);
+            
+            auto ang = jmap(pos, 0.f, 1.f, startAng, endAng);
+            
+            auto  c = center.getPointOnCircumference(radius + getTextHeight() * 0.5f + 1, ang); // getting the point where the text will be placed
+            
+            // drawing a rectangle for the text and positioning it at point c
+            Rectangle<float> r;
+            auto str = labels[i].label;
+            r.setSize(lg.getCurrentFont().getStringWidth(str), getTextHeight());
+            r.setCentre(c);
+            r.setY(r.getY() + getTextHeight());
+            
+            // drawing the text inside that rectangle
+            lg.drawFittedText(str, r.toNearestInt(), juce::Justification::centred, 1);
+        }
+    });
+}
+
+void RotarySliderWithLabels::resized()
+{
+    juce::Slider::resized();
+    
+    // the labels move with the knob
+    labelRing.clear();
 }
 
 juce::Rectangle<int> RotarySliderWithLabels::getSliderbounds() const
@@ -264,25 +332,54 @@ juce::String RotarySliderWithLabels::getDisplayString() const
 ResponseCurveComponent::ResponseCurveComponent(SSimpleEQAudioProcessor& p) :
 audioProcessor(p),
 //leftChannelFifo(&audioProcessor.leftChannelFifo)
-leftPathProducer(audioProcessor.leftChannelFifo),
-rightPathProducer(audioProcessor.rightChannelFifo)
+leftPathProducer(audioProcessor.analyzerFifo.getChannelFifo(Channel::Left)),
+rightPathProducer(audioProcessor.analyzerFifo.getChannelFifo(Channel::Right)),
+analyzerResolution(audioProcessor.apvts.getRawParameterValue("Analyzer Resolution")),
+analyzerBallistics(audioProcessor.apvts.getRawParameterValue("Analyzer Ballistics")),
+analyzerOverlap(audioProcessor.apvts.getRawParameterValue("Analyzer Overlap")),
+analyzerEnabled(audioProcessor.apvts.getRawParameterValue("Analyzer Enabled")),
+analyzerThread(leftPathProducer, rightPathProducer)
 {
     const auto& params = audioProcessor.getParameters();
     for(auto param : params)
     {
         param->addListener(this);
+        
+        // which band, if any, a change to this parameter has to redraw
+        auto band = -1;
+        if( auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param) )
+        {
+            if( paramWithID->paramID.startsWith("LowCut") )
+                band = ChainPositions::LowCut;
+            else if( paramWithID->paramID.startsWith("Peak") )
+                band = ChainPositions::Peak;
+            else if( paramWithID->paramID.startsWith("HighCut") )
+                band = ChainPositions::HighCut;
+        }
+        
+        parameterBands.push_back(band);
     }
 //    below two lines now in PathProducer's constructor
 //    leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
 //    monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
     
     
-    updateChain();
-    startTimerHz(60);
+    // the curves themselves get worked out once the component has a size
+    curveSampleRate = audioProcessor.getSampleRate();
+    updateChain(allBands);
+    
+    // the editor can open with the analyzer already switched off
+    toggleAnalysisEnablement(analyzerEnabled->load() > 0.5f);
+    
+    audioProcessor.addAnalyzerConsumer();
+    analyzerThread.startThread(juce::Thread::Priority::low);
+    startTimerHz(frameRate);
 }
 
 ResponseCurveComponent::~ResponseCurveComponent()
 {
+    audioProcessor.removeAnalyzerConsumer();
+    
     const auto& params = audioProcessor.getParameters();
     for(auto param : params)
     {
@@ -292,110 +389,630 @@ ResponseCurveComponent::~ResponseCurveComponent()
 
 void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float newValue)
 {
-    parametersChanged.set(true);
+    if( parameterIndex < 0 || parameterIndex >= (int)parameterBands.size() )
+        return;
+    
+    auto band = parameterBands[(size_t)parameterIndex];
+    if( band >= 0 )
+        parametersChanged.fetch_or(1 << band);
+}
+
+AnalyzerBand::AnalyzerBand(FFTOrder initialOrder) : generator(initialOrder)
+{
+    history.setSize(1, generator.getFFTSize());
+    history.clear();
+}
+
+void AnalyzerBand::reset()
+{
+    history.clear();
+    writePosition = 0;
+    samplesSinceLastFrame = 0;
+    generator.resetBallistics(-48.f);
+}
+
+bool AnalyzerBand::updateOrder()
+{
+    if (! generator.updateOrder())
+        return false;
+    
+    // the history has to be the new size, and since it's about to be filled from scratch
+    // the next frame waits for a whole hop
+    history.setSize(1, generator.getFFTSize());
+    history.clear();
+    writePosition = 0;
+    samplesSinceLastFrame = 0;
+    
+    return true;
+}
+
+void AnalyzerBand::setHop(int newHopSize, AnalyzerBallistics ballistics, double framesPerSecond)
+{
+    hopSize = newHopSize;
+    
+    // the overlap may have been raised since last time, in which case the next frame is due right away
+    samplesSinceLastFrame = juce::jmin(samplesSinceLastFrame, hopSize - 1);
+    
+    // a frame every hop, which is what the averaging and the peak decay have to be scaled to
+    generator.setBallistics(ballistics, framesPerSecond);
+}
+
+void AnalyzerBand::push(const float* source, int remaining)
+{
+    const auto historySize = history.getNumSamples();
+    
+    while (remaining > 0) {
+        
+        // up to whichever comes first: the next frame, or the end of the history where it wraps
+        auto numToCopy = juce::jmin(remaining, hopSize - samplesSinceLastFrame, historySize - writePosition);
+        
+        juce::FloatVectorOperations::copy(history.getWritePointer(0, writePosition), source, numToCopy);
+        
+        source += numToCopy;
+        remaining -= numToCopy;
+        samplesSinceLastFrame += numToCopy;
+        writePosition += numToCopy;
+        
+        if (writePosition == historySize)
+            writePosition = 0;
+        
+        // the write position is also where the oldest sample lives
+        if (samplesSinceLastFrame == hopSize) {
+            samplesSinceLastFrame = 0;
+            generator.produceFFTDataForRendering(history.getReadPointer(0), writePosition, -48.f);
+        }
+    }
 }
 
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+bool AnalyzerBand::copyNewestSpectrum(std::vector<float>& spectrum)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
+    auto numFrames = generator.getNumAvailableFFTDataBlocks();
     
-    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0) { // check until buffers are available
+    for (int i = 0; i < numFrames; ++i) {
         
-        if (leftChannelFifo -> getAudioBuffer(tempIncomingBuffer)) { // check if you can pull the buffer into the temp buffer
-            
-            auto size = tempIncomingBuffer.getNumSamples();
+        auto* fftData = generator.getNextFFTData();
+        
+        if (i == numFrames - 1) {
+            spectrum.resize((size_t)generator.getFFTSize() / 2);
+            std::copy(fftData->begin(), fftData->begin() + (std::ptrdiff_t)spectrum.size(), spectrum.begin());
+        }
+        
+        generator.finishedReadingFFTData();
+    }
+    
+    return numFrames > 0;
+}
+
+//==============================================================================
+int PathProducer::getHopSize() const
+{
+    const auto fftSize = fullBand.generator.getFFTSize();
+    
+    switch (overlap)
+    {
+        case FFTOverlap::none: return fftSize;
+        case FFTOverlap::quarter: return fftSize * 3 / 4;
+        case FFTOverlap::half: return fftSize / 2;
+        case FFTOverlap::threeQuarters: return fftSize / 4;
+    }
+    
+    return fftSize;
+}
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-                                              monoBuffer.getReadPointer(0, size),
-                                              monoBuffer.getNumSamples() - size);
+void PathProducer::pushToLowBand(const float* samples, int numSamples)
+{
+    auto& scratch = lowBand->scratch;
+    
+    while (numSamples > 0) {
+        
+        auto numToDecimate = juce::jmin(numSamples, (int)scratch.size());
+        
+        // the second stage runs in place on what the first one left in the scratch buffer
+        auto numHalved = lowBand->decimators[0].process(samples, numToDecimate, scratch.data());
+        auto numQuartered = lowBand->decimators[1].process(scratch.data(), numHalved, scratch.data());
+        
+        lowBand->band.push(scratch.data(), numQuartered);
+        
+        samples += numToDecimate;
+        numSamples -= numToDecimate;
+    }
+}
+
+bool PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    // multi-resolution was switched on or off, the low band only takes up memory while it's wanted
+    if (multiResolution.load() != (lowBand != nullptr)) {
+        if (lowBand == nullptr)
+            lowBand = std::make_unique<LowBand>();
+        else
+            lowBand.reset();
+    }
+    
+    // capture was off for a while or the fifo was re-prepared, start from silence rather than splice old audio onto new
+    if (leftChannelFifo->checkForRestart()) {
+        fullBand.reset();
+        
+        if (lowBand != nullptr) {
+            for (auto& decimator : lowBand->decimators)
+                decimator.reset();
+            
+            lowBand->band.reset();
+            lowBand->spectrum.clear();
+        }
+        
+        publishedTraces.getWriteBuffer().numPoints = 0;
+        publishTraceIfChanged();
+    }
+    
+    // a new resolution may have finished building in the background
+    fullBand.updateOrder();
+    
+    const auto hopSize = getHopSize();
+    const auto framesPerSecond = sampleRate / (double)hopSize;
+    
+    fullBand.setHop(hopSize, ballistics.load(), framesPerSecond);
+    
+    // the same overlap in decimated samples, so a quarter as many frames. the bass doesn't move fast enough
+    // to need more, and it keeps the low band's FFTs down to a quarter of the full band's
+    if (lowBand != nullptr)
+        lowBand->band.setHop(hopSize, ballistics.load(), framesPerSecond / LowBand::decimation);
+    
+    // every complete buffer is read straight out of its fifo slot
+    auto readAnything = false;
+    
+    while (auto* incomingBuffer = leftChannelFifo->getNextAudioBuffer()) {
+        
+        readAnything = true;
+        
+        auto* source = incomingBuffer->getReadPointer(0);
+        auto numSamples = incomingBuffer->getNumSamples();
+        
+        fullBand.push(source, numSamples);
+        
+        if (lowBand != nullptr)
+            pushToLowBand(source, numSamples);
+        
+        leftChannelFifo->finishedReadingAudioBuffer();
+    }
+    
+    // until the low band has a frame of its own the full band covers everything
+    AnalyzerSpectrum lowBandSpectrum;
+    float crossover = 0.f;
+    
+    if (lowBand != nullptr) {
+        lowBand->band.copyNewestSpectrum(lowBand->spectrum);
+        
+        if (! lowBand->spectrum.empty()) {
+            const auto lowBandRate = sampleRate / LowBand::decimation;
             
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                                              tempIncomingBuffer.getReadPointer(0, 0),
-                                              size);
+            lowBandSpectrum = { lowBand->spectrum.data(),
+                                (int)lowBand->spectrum.size(),
+                                float(lowBandRate / lowBand->band.generator.getFFTSize()) };
             
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, -48.f);
+            // a quarter of the way to the low band's nyquist, well inside where both half-band stages are flat
+            crossover = float(lowBandRate / 8.0);
         }
     }
     
     /*
-     if there are FFT data buffers to pull
-        if we can pull a buffer
-            generate a path
+     the ballistics have already been applied to every FFT frame on its way in,
+     so only the newest one needs turning into a trace, the older ones are just handed back
      */
-//    const auto fftBounds = getAnalysisArea().toFloat();
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
+    const auto fftSize = fullBand.generator.getFFTSize();
     
     /*
      48000 / 2048 = 23hz  <- this is the bin width
     */
     const auto binWidth = sampleRate / double(fftSize);
     
-    while ( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 ) {
+    auto numFrames = fullBand.generator.getNumAvailableFFTDataBlocks();
+    
+    for (int i = 0; i < numFrames; ++i) {
         
-        std::vector<float> fftData;
+        auto* fftData = fullBand.generator.getNextFFTData();
         
-        if (leftChannelFFTDataGenerator.getFFTData(fftData)) {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, -48.f);
+        if (i == numFrames - 1) {
+            AnalyzerSpectrum fullBandSpectrum { fftData->data(), fftSize / 2, (float)binWidth };
+            
+            pathProducer.generatePath(fullBandSpectrum, lowBandSpectrum, crossover, fftBounds, -48.f,
+                                      publishedTraces.getWriteBuffer());
+            publishTraceIfChanged();
         }
+        
+        fullBand.generator.finishedReadingFFTData();
     }
     
+    return readAnything;
+}
+
+void PathProducer::publishTraceIfChanged()
+{
+    auto& trace = publishedTraces.getWriteBuffer();
     
-    /*
-     while there are paths that can be pull
-        pull as many as we can
-            display the most recent path
-     */
-    while (pathProducer.getNumPathsAvailable() > 0) {
-        pathProducer.getPath(leftChannelFFTPath);
+    // a stopped transport with the host still calling processBlock comes out as the same trace every frame
+    auto changed = trace.numPoints != lastPublishedTrace.numPoints;
+    
+    for (int i = 0; i < trace.numPoints && ! changed; ++i) {
+        auto& point = trace.points[(size_t)i];
+        auto& lastPoint = lastPublishedTrace.points[(size_t)i];
+        
+        changed = point.x != lastPoint.x || std::abs(point.y - lastPoint.y) >= traceChangeThreshold;
+    }
+    
+    if (! changed)
+        return;
+    
+    // keeps its storage, so this only allocates when the trace gets more points than it has had before
+    lastPublishedTrace.points.assign(trace.points.begin(), trace.points.begin() + trace.numPoints);
+    lastPublishedTrace.numPoints = trace.numPoints;
+    
+    publishedTraces.publish();
+}
+
+//==============================================================================
+AnalyzerThread::AnalyzerThread(PathProducer& left, PathProducer& right) :
+juce::Thread("SSimpleEQ Analyzer"),
+leftPathProducer(left),
+rightPathProducer(right)
+{
+}
+
+AnalyzerThread::~AnalyzerThread()
+{
+    // stopThread() notifies, so a thread waiting for the next round wakes up and exits
+    stopThread(1000);
+}
+
+void AnalyzerThread::setAnalysisArea(juce::Rectangle<float> newArea)
+{
+    const juce::SpinLock::ScopedLockType lock(areaLock);
+    analysisArea = newArea;
+}
+
+void AnalyzerThread::setActive(bool shouldBeActive)
+{
+    active.store(shouldBeActive);
+    notify();
+}
+
+void AnalyzerThread::run()
+{
+    auto audioArriving = false;
+    
+    while (! threadShouldExit()) {
+        
+        // nothing came in last round, so there's no point polling until the editor says there is
+        wait(active.load() && audioArriving ? intervalMs : -1);
+        
+        if (threadShouldExit())
+            return;
+        
+        juce::Rectangle<float> area;
+        {
+            const juce::SpinLock::ScopedLockType lock(areaLock);
+            area = analysisArea;
+        }
+        
+        auto rate = sampleRate.load();
+        
+        auto leftRead = leftPathProducer.process(area, rate);
+        auto rightRead = rightPathProducer.process(area, rate);
+        audioArriving = leftRead || rightRead;
     }
 }
 
 void ResponseCurveComponent::timerCallback()
 {
+    auto tickStart = juce::Time::getMillisecondCounterHiRes();
+    auto somethingChanged = false;
+    
+    // a new background once the size has stopped changing, it covers the whole component
+    if( backgroundOutOfDate && juce::Time::getMillisecondCounter() - lastResizeTime >= backgroundRebuildDelayMs )
+    {
+        rebuildBackground();
+        repaint();
+        somethingChanged = true;
+    }
+    
+    auto enabled = analyzerEnabled->load() > 0.5f;
+    if( enabled != shouldShowFFTAnalysis )
+        toggleAnalysisEnablement(enabled);
+    
     if (shouldShowFFTAnalysis) {
         
-        auto fftBounds = getAnalysisArea().toFloat();
-        auto sampleRate = audioProcessor.getSampleRate();
+        // cheap to repeat, a new FFT only gets built when the choice actually changes.
+        // the choice after the last order is multi-resolution, which runs the full band at 2048
+        auto resolution = (int)analyzerResolution->load();
+        auto multiResolution = resolution > FFTOrder::order8192 - FFTOrder::order2048;
+        auto order = multiResolution ? FFTOrder::order2048 : static_cast<FFTOrder>(FFTOrder::order2048 + resolution);
         
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+        leftPathProducer.setFFTOrder(order);
+        rightPathProducer.setFFTOrder(order);
+        leftPathProducer.setMultiResolution(multiResolution);
+        rightPathProducer.setMultiResolution(multiResolution);
+        
+        auto newBallistics = static_cast<AnalyzerBallistics>((int)analyzerBallistics->load());
+        leftPathProducer.setBallistics(newBallistics);
+        rightPathProducer.setBallistics(newBallistics);
+        
+        auto newOverlap = static_cast<FFTOverlap>((int)analyzerOverlap->load());
+        leftPathProducer.setOverlap(newOverlap);
+        rightPathProducer.setOverlap(newOverlap);
+        
+        analyzerThread.setSampleRate(audioProcessor.getSampleRate());
+        
+        // the analyzer thread goes to sleep whenever it runs dry, this is what gets it going again
+        if( leftPathProducer.hasPendingAudio() || rightPathProducer.hasPendingAudio() )
+            analyzerThread.notify();
+        
+        // take whatever the analyzer thread finished since last time, it runs on its own schedule.
+        // the producers only publish traces that moved, so no new trace means nothing new to draw
+        auto newLeftTrace = leftPathProducer.updateTrace();
+        auto newRightTrace = rightPathProducer.updateTrace();
+        somethingChanged |= newLeftTrace || newRightTrace;
+    
+    }
     
+    // every band's coefficients depend on the sample rate
+    auto sampleRate = audioProcessor.getSampleRate();
+    if( sampleRate != curveSampleRate )
+    {
+        curveSampleRate = sampleRate;
+        parametersChanged.fetch_or(allBands);
     }
     
-    if(parametersChanged.compareAndSetBool(false, true))
+    // only the bands that changed get their coefficients and their curve redone
+    auto changedBands = parametersChanged.exchange(0);
+    if( changedBands != 0 )
     {
-        updateChain();
-//        repaint();
+        updateChain(changedBands);
+        updateResponseCurve(changedBands);
+        somethingChanged = true;
     }
     
-    repaint();
+    // the traces and the curve never draw outside the render area, the rest of the component is static
+    if( somethingChanged )
+        repaint(getRenderArea());
+    
+    updateFrameRate(somethingChanged, juce::Time::getMillisecondCounterHiRes() - tickStart);
 }
 
-void ResponseCurveComponent::updateChain()
+void ResponseCurveComponent::updateFrameRate(bool somethingChanged, double tickCostMs)
 {
-    // update the mono chain
+    using namespace juce;
+    
+    // a paint since the last tick means a frame got drawn, and that plus a tick is what a frame costs.
+    // a slow moving average, one slow frame shouldn't change anything
+    if( paintCostMs > 0.0 )
+    {
+        frameCostMs += 0.1 * (tickCostMs + paintCostMs - frameCostMs);
+        paintCostMs = 0.0;
+    }
+    
+    // a frame gets about a quarter of its period. when the machine is busy frames take longer, and we back off
+    auto affordableFrameRate = activeFrameRate;
+    if( frameCostMs > 0.0 )
+        affordableFrameRate = jlimit(minimumLoadedFrameRate, activeFrameRate, (int)(250.0 / frameCostMs));
+    
+    idleTicks = somethingChanged ? 0 : idleTicks + 1;
+    
+    // after half a second with nothing new we're only waiting to notice the next change
+    auto newFrameRate = idleTicks > frameRate / 2 ? idleFrameRate : affordableFrameRate;
+    
+    if( newFrameRate != frameRate )
+    {
+        frameRate = newFrameRate;
+        startTimerHz(frameRate);
+    }
+}
+
+void ResponseCurveComponent::updateChain(int changedBands)
+{
+    // update the mono chain, just the bands that changed
     auto chainSettings = getChainSettings(audioProcessor.apvts);
+    auto sampleRate = audioProcessor.getSampleRate();
+    
+    if( changedBands & (1 << ChainPositions::LowCut) )
+    {
+        monoChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+        
+        auto lowCutCoefficients = makeLowCutFilter<float>(chainSettings, sampleRate);
+        updateCutFilter(monoChain.get<ChainPositions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
+    }
+    
+    if( changedBands & (1 << ChainPositions::Peak) )
+    {
+        monoChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+        
+        auto peakCoefficients = makePeakFilter<float>(chainSettings, sampleRate);
+        updateCoefficients(monoChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    }
+    
+    if( changedBands & (1 << ChainPositions::HighCut) )
+    {
+        monoChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+        
+        auto highCutCoefficients = makeHighCutFilter<float>(chainSettings, sampleRate);
+        updateCutFilter(monoChain.get<ChainPositions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
+    }
+}
+
+namespace
+{
+    // the stages of a cut filter that are in use, as sections for the response evaluator. returns how many
+    template<typename CutChain>
+    int getCutFilterSections(const CutChain& cutChain, DSPKernels::SectionCoefficients* sections)
+    {
+        int numSections = 0;
+        
+        if( !cutChain.template isBypassed<0>() )
+            sections[numSections++] = makeSection(*cutChain.template get<0>().coefficients);
+        if( !cutChain.template isBypassed<1>() )
+            sections[numSections++] = makeSection(*cutChain.template get<1>().coefficients);
+        if( !cutChain.template isBypassed<2>() )
+            sections[numSections++] = makeSection(*cutChain.template get<2>().coefficients);
+        if( !cutChain.template isBypassed<3>() )
+            sections[numSections++] = makeSection(*cutChain.template get<3>().coefficients);
+        
+        return numSections;
+    }
+}
+
+void ResponseCurveComponent::updateResponseGrid()
+{
+    using namespace juce;
+    
+    auto w = jmax(0, getAnalysisArea().getWidth());
+    auto sampleRate = audioProcessor.getSampleRate();
+    
+    if( w == responseEvaluator.getNumFrequencies() && sampleRate == responseEvaluator.getSampleRate() )
+        return;
+    
+    // one frequency per pixel column. only happens on a resize or a new sample rate, so allocating here is fine
+    std::vector<double> freqs((size_t)w);
+    
+    for( int i = 0; i < w; ++i )
+        freqs[(size_t)i] = mapToLog10(double(i)/double(w), 20.0, 20000.0);
+    
+    responseEvaluator.setFrequencies(freqs.data(), w, sampleRate);
+}
+
+void ResponseCurveComponent::updateBandMagnitudes(int band)
+{
+    using namespace juce;
+    
+    updateResponseGrid();
+    
+    // a bypassed band has no sections, which comes out flat, 0dB all the way along
+    std::array<DSPKernels::SectionCoefficients, 4> sections;
+    int numSections = 0;
+    
+    if( band == ChainPositions::Peak )
+    {
+        if( !monoChain.isBypassed<ChainPositions::Peak>() )
+            sections[numSections++] = makeSection(*monoChain.get<ChainPositions::Peak>().coefficients);
+    }
+    else if( band == ChainPositions::LowCut )
+    {
+        if( !monoChain.isBypassed<ChainPositions::LowCut>() )
+            numSections = getCutFilterSections(monoChain.get<ChainPositions::LowCut>(), sections.data());
+    }
+    else
+    {
+        if( !monoChain.isBypassed<ChainPositions::HighCut>() )
+            numSections = getCutFilterSections(monoChain.get<ChainPositions::HighCut>(), sections.data());
+    }
+    
+    // the whole band over every column in one go
+    responseEvaluator.evaluate(sections.data(), numSections);
+    
+    // keeps its storage unless the component got wider
+    auto w = responseEvaluator.getNumFrequencies();
+    auto& mags = bandMagnitudes[(size_t)band];
+    mags.resize((size_t)w);
+    
+    FloatVectorOperations::copy(mags.data(), responseEvaluator.getDecibels(), w);
+}
+
+void ResponseCurveComponent::updateResponseCurve(int changedBands)
+{
+    using namespace juce;
+    
+    for( int band = 0; band < numBands; ++band )
+    {
+        if( changedBands & (1 << band) )
+            updateBandMagnitudes(band);
+    }
+    
+    auto responseArea = getAnalysisArea();
+    
+    const double outputMin = responseArea.getBottom();
+    const double outputMax = responseArea.getY();
+    auto map = [outputMin, outputMax](double input)
+    {
+        return jmap(input, -24.0, 24.0, outputMin, outputMax);
+    };
     
-    monoChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    monoChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    monoChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    // the bands multiply, so in dB they just add up
+    auto& lowCut = bandMagnitudes[ChainPositions::LowCut];
+    auto& peak = bandMagnitudes[ChainPositions::Peak];
+    auto& highCut = bandMagnitudes[ChainPositions::HighCut];
     
-    auto peakCoefficients = makePeakFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCoefficients(monoChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    auto numColumns = jmin(lowCut.size(), peak.size(), highCut.size());
     
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, audioProcessor.getSampleRate());
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, audioProcessor.getSampleRate());
+    // clear() keeps the path's storage, so once it's been drawn at this width it never allocates again
+    responseCurve.clear();
     
-    updateCutFilter(monoChain.get<ChainPositions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(monoChain.get<ChainPositions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
+    if( numColumns == 0 )
+        return;
+    
+    responseCurve.startNewSubPath(responseArea.getX(), map(double(lowCut[0] + peak[0] + highCut[0])));
+    
+    for( size_t i = 1; i < numColumns; ++i )
+    {
+        responseCurve.lineTo(responseArea.getX() + i, map(double(lowCut[i] + peak[i] + highCut[i])));
+    }
 }
 
 void ResponseCurveComponent::resized()
 {
     using namespace juce;
-    background = Image(Image::PixelFormat::RGB, getWidth(), getHeight(), true);
     
-    Graphics g(background);
+    analyzerThread.setAnalysisArea(getAnalysisArea().toFloat());
+    
+    // a new width means a new set of columns for every band
+    updateResponseCurve(allBands);
+    
+    // room for a point in every column, which is as many as a trace can have
+    analyzerPath.preallocateSpace(3 * (getAnalysisArea().getWidth() + 1));
+    
+    // the old background gets stretched while the size is still changing, the timer redraws it once it settles
+    lastResizeTime = Time::getMillisecondCounter();
+    backgroundOutOfDate = true;
+}
+
+const ResponseCurveComponent::BackgroundLayer* ResponseCurveComponent::findBackgroundLayer() const
+{
+    for( auto& layer : backgroundLayers )
+    {
+        if( layer.bounds == getLocalBounds() && layer.scale == paintScale )
+            return &layer;
+    }
+    
+    return nullptr;
+}
+
+void ResponseCurveComponent::rebuildBackground()
+{
+    using namespace juce;
+    
+    auto bounds = getLocalBounds();
+    
+    // the ones at other sizes are no use any more, and there's a new one at this scale
+    backgroundLayers.erase(std::remove_if(backgroundLayers.begin(), backgroundLayers.end(), [&](const BackgroundLayer& layer)
+    {
+        return layer.bounds != bounds || layer.scale == paintScale;
+    }), backgroundLayers.end());
+    
+    if( backgroundLayers.size() >= maxBackgroundLayers )
+        backgroundLayers.erase(backgroundLayers.begin());
+    
+    Image image(Image::PixelFormat::RGB,
+                jmax(1, roundToInt(bounds.getWidth() * paintScale)),
+                jmax(1, roundToInt(bounds.getHeight() * paintScale)),
+                true);
+    
+    Graphics g(image);
+    g.addTransform(AffineTransform::scale(paintScale));
+    drawBackground(g);
+    
+    backgroundLayers.push_back({ image, bounds, paintScale });
+    backgroundOutOfDate = false;
+}
+
+void ResponseCurveComponent::drawBackground(juce::Graphics& g)
+{
+    using namespace juce;
     
     Array<float> freqs
     {
@@ -522,108 +1139,74 @@ juce::Rectangle<int> ResponseCurveComponent::getAnalysisArea()
     return bounds;
 }
 
-void ResponseCurveComponent::paint (juce::Graphics& g)
+void ResponseCurveComponent::drawAnalyzerTrace(juce::Graphics& g, const AnalyzerTrace& trace)
 {
-    using namespace juce;
+    if (trace.numPoints == 0)
+        return;
     
-    g.fillAll(Colours::black);
-    
-    g.drawImage(background, getLocalBounds().toFloat());
-
-    auto responseArea = getAnalysisArea();
+    // the points are already where they belong, and clear() hangs on to the path's storage
+    analyzerPath.clear();
+    analyzerPath.startNewSubPath(trace.points[0]);
     
-    auto w = responseArea.getWidth();
+    for (int i = 1; i < trace.numPoints; ++i)
+        analyzerPath.lineTo(trace.points[(size_t)i]);
     
-    auto& lowCut = monoChain.get<ChainPositions::LowCut>();
-    auto& peak = monoChain.get<ChainPositions::Peak>();
-    auto& highCut = monoChain.get<ChainPositions::HighCut>();
+    g.strokePath(analyzerPath, juce::PathStrokeType(1.f));
+}
+
+void ResponseCurveComponent::paint (juce::Graphics& g)
+{
+    using namespace juce;
     
-    auto sampleRate = audioProcessor.getSampleRate();
+    auto paintStart = Time::getMillisecondCounterHiRes();
     
-    std::vector<double> mags;
+    g.fillAll(Colours::black);
     
-    mags.resize(w);
+    paintScale = g.getInternalContext().getPhysicalPixelScaleFactor();
     
-    for(int i=0; i<w; ++i)
+    if( auto* layer = findBackgroundLayer() )
     {
-        double mag = 1.f;
-        auto freq = mapToLog10(double(i)/double(w), 20.0, 20000.0);
-        
-        if(!monoChain.isBypassed<ChainPositions::Peak>())
-            mag *= peak.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if( !monoChain.isBypassed<ChainPositions::LowCut>() )
-        {
-            if(!lowCut.isBypassed<0>())
-                mag *= lowCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if(!lowCut.isBypassed<1>())
-                mag *= lowCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if(!lowCut.isBypassed<2>())
-                mag *= lowCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if(!lowCut.isBypassed<3>())
-                mag *= lowCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        }
-        
-        if( !monoChain.isBypassed<ChainPositions::HighCut>() )
-        {
-            if(!highCut.isBypassed<0>())
-                mag *= highCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if(!highCut.isBypassed<1>())
-                mag *= highCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if(!highCut.isBypassed<2>())
-                mag *= highCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if(!highCut.isBypassed<3>())
-                mag *= highCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        }
-        if(!highCut.isBypassed<0>())
-            mag *= highCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highCut.isBypassed<1>())
-            mag *= highCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highCut.isBypassed<2>())
-            mag *= highCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highCut.isBypassed<3>())
-            mag *= highCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        mags[i] = Decibels::gainToDecibels(mag);
+        g.drawImage(layer->image, getLocalBounds().toFloat());
     }
-    
-    Path responseCurve;
-
-    const double outputMin = responseArea.getBottom();
-    const double outputMax = responseArea.getY();
-    auto map = [outputMin, outputMax](double input)
+    else if( backgroundLayers.empty() )
     {
-        return jmap(input, -24.0, 24.0, outputMin, outputMax);
-    };
-
-    responseCurve.startNewSubPath(responseArea.getX(), map(mags.front()));
-
-    for( size_t i = 1; i < mags.size(); ++i )
+        // nothing to stretch in the meantime, so the very first one gets drawn straight away
+        rebuildBackground();
+        g.drawImage(backgroundLayers.back().image, getLocalBounds().toFloat());
+    }
+    else
     {
-        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
+        // the newest one stretched, cheaply, until the timer gets round to a new one at this size and scale
+        backgroundOutOfDate = true;
+        
+        Graphics::ScopedSaveState saveState(g);
+        g.setImageResamplingQuality(Graphics::lowResamplingQuality);
+        g.drawImage(backgroundLayers.back().image, getLocalBounds().toFloat());
     }
     
-    if( shouldShowFFTAnalysis )
     {
-        auto leftChannelFFTPath = leftPathProducer.getPath();
-        leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-
-        g.setColour(Colours::skyblue);
-        g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+        // the timer only repaints the render area, so nothing that changes may draw outside it.
+        // a cut filter's curve heads off the bottom of the area otherwise
+        Graphics::ScopedSaveState saveState(g);
+        g.reduceClipRegion(getRenderArea());
         
-        auto rightChannelFFTPath = rightPathProducer.getPath();
-        rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-
-        g.setColour(Colours::yellow);
-        g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
-    }
+        if( shouldShowFFTAnalysis )
+        {
+            g.setColour(Colours::skyblue);
+            drawAnalyzerTrace(g, leftPathProducer.getTrace());
+            
+            g.setColour(Colours::yellow);
+            drawAnalyzerTrace(g, rightPathProducer.getTrace());
+        }
         
-    g.setColour(Colours::orange);
-    g.drawRoundedRectangle(getRenderArea().toFloat(), 4.f, 1.f);
-
-    g.setColour(Colours::white);
-    g.strokePath(responseCurve, PathStrokeType(2.f));
-
+        g.setColour(Colours::orange);
+        g.drawRoundedRectangle(getRenderArea().toFloat(), 4.f, 1.f);
+        
+        g.setColour(Colours::white);
+        g.strokePath(responseCurve, PathStrokeType(2.f));
+    }
+    
+    paintCostMs += Time::getMillisecondCounterHiRes() - paintStart;
 }
 
 //==============================================================================
@@ -646,10 +1229,21 @@ highCutFreqSliderAttachment(audioProcessor.apvts, "HighCut Freq", highCutFreqSli
 lowCutSlopeSliderAttachment(audioProcessor.apvts, "LowCut Slope", lowCutSlopeSlider),
 highCutSlopeSliderAttachment(audioProcessor.apvts, "HighCut Slope", highCutSlopeSlider),
 
+analyzerResolutionBox(*dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Analyzer Resolution"))),
+analyzerBallisticsBox(*dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Analyzer Ballistics"))),
+analyzerOverlapBox(*dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Analyzer Overlap"))),
+filterModeBox(*dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Filter Mode"))),
+processingCoresBox(*dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Processing Cores"))),
+
 lowCutBypassButtonAttachment(audioProcessor.apvts, "LowCut Bypass", lowCutBypassButton),
 peakBypassButtonAttachment(audioProcessor.apvts, "Peak Bypass", peakBypassButton),
 highCutBypassButtonAttachment(audioProcessor.apvts, "HighCut Bypass", highCutBypassButton),
-analyzerEnabledButtonAttachment(audioProcessor.apvts, "Analyzer Enabled", analyzerEnabledButton)
+analyzerEnabledButtonAttachment(audioProcessor.apvts, "Analyzer Enabled", analyzerEnabledButton),
+analyzerResolutionBoxAttachment(audioProcessor.apvts, "Analyzer Resolution", analyzerResolutionBox),
+analyzerBallisticsBoxAttachment(audioProcessor.apvts, "Analyzer Ballistics", analyzerBallisticsBox),
+analyzerOverlapBoxAttachment(audioProcessor.apvts, "Analyzer Overlap", analyzerOverlapBox),
+filterModeBoxAttachment(audioProcessor.apvts, "Filter Mode", filterModeBox),
+processingCoresBoxAttachment(audioProcessor.apvts, "Processing Cores", processingCoresBox)
 
 {
     
@@ -723,14 +1317,9 @@ analyzerEnabledButtonAttachment(audioProcessor.apvts, "Analyzer Enabled", analyz
         }
     };
     
-    analyzerEnabledButton.onClick = [safePtr]()
-    {
-        if(auto comp = safePtr.getComponent())
-        {
-            auto enabled = comp->analyzerEnabledButton.getToggleState();
-            comp->responseCurveComponent.toggleAnalysisEnablement(enabled);
-        }
-    };
+    // "Filter Mode" only picks between the float cascade's modes, the double path always runs JUCE's filters.
+    // hosts settle on the precision before prepareToPlay, which is before the editor is opened
+    filterModeBox.setEnabled( ! audioProcessor.isUsingDoublePrecision() );
     
     peakBypassButton.setLookAndFeel(&lnf);
     lowCutBypassButton.setLookAndFeel(&lnf);
@@ -760,12 +1349,23 @@ void SSimpleEQAudioProcessorEditor::resized()
     auto bounds = getLocalBounds();
     
     auto analyzerEnabledArea = bounds.removeFromTop(25);
-    analyzerEnabledArea.setWidth(100);
+    analyzerEnabledArea.setWidth(90);
     analyzerEnabledArea.setX(5);
     analyzerEnabledArea.removeFromTop(2);
     
     analyzerEnabledButton.setBounds(analyzerEnabledArea);
     
+    auto analyzerResolutionArea = analyzerEnabledArea.withX(analyzerEnabledArea.getRight() + 5);
+    analyzerResolutionBox.setBounds(analyzerResolutionArea);
+    auto analyzerBallisticsArea = analyzerResolutionArea.withX(analyzerResolutionArea.getRight() + 5);
+    analyzerBallisticsBox.setBounds(analyzerBallisticsArea);
+    analyzerOverlapBox.setBounds(analyzerBallisticsArea.withX(analyzerBallisticsArea.getRight() + 5));
+    
+    // the processing options sit at the other end of the row
+    auto filterModeArea = analyzerEnabledArea.withX(getWidth() - 5 - analyzerEnabledArea.getWidth());
+    filterModeBox.setBounds(filterModeArea);
+    processingCoresBox.setBounds(filterModeArea.withX(filterModeArea.getX() - 5 - filterModeArea.getWidth()));
+    
     bounds.removeFromTop(5);
     
     float hratio = 25.f / 100.f;
@@ -808,6 +1408,11 @@ std::vector<juce::Component*> SSimpleEQAudioProcessorEditor::getComps()
         &lowCutBypassButton,
         &highCutBypassButton,
         &peakBypassButton,
-        &analyzerEnabledButton
+        &analyzerEnabledButton,
+        &analyzerResolutionBox,
+        &analyzerBallisticsBox,
+        &analyzerOverlapBox,
+        &filterModeBox,
+        &processingCoresBox
     };
 }
@@ -9,7 +9,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <future>
 #include "PluginProcessor.h"
+#include "HalfBandDecimator.h"
+#include "FrequencyResponse.h"
+#include "Filmstrip.h"
 
 
 enum FFTOrder
@@ -19,142 +23,388 @@ enum FFTOrder
     order8192 = 13
 };
 
+/*
+ how much consecutive analyzer frames overlap. the hop between frames is what's left over,
+ so a new FFT is done every fftSize * (1 - overlap) samples whatever the host's block size is.
+ */
+enum class FFTOverlap
+{
+    none,
+    quarter,
+    half,
+    threeQuarters
+};
+
+/*
+ how the analyzer trace moves from frame to frame, same order as the "Analyzer Ballistics" choices.
+ fast and slow average every bin over roughly 125 ms and 1 s, peak hold averages like fast and then
+ holds on to the highest level, letting it fall back at 12 dB per second.
+ */
+enum class AnalyzerBallistics
+{
+    raw,
+    fast,
+    slow,
+    peakHold
+};
+
+/*
+ the stage that comes after the FFT: decibels, averaging and peak hold for every bin in a single pass
+ (DSPKernels::SpectrumKernel). it keeps each bin's average and peak between frames.
+ */
+struct SpectrumProcessor
+{
+    void prepare(int numBins, float negativeInfinity)
+    {
+        average.assign((size_t)numBins, negativeInfinity);
+        peak.assign((size_t)numBins, negativeInfinity);
+    }
+    
+    void reset(float negativeInfinity)
+    {
+        std::fill(average.begin(), average.end(), negativeInfinity);
+        std::fill(peak.begin(), peak.end(), negativeInfinity);
+    }
+    
+    // the time constants are in seconds, so they have to be turned into per frame amounts
+    void setBallistics(AnalyzerBallistics ballistics, double framesPerSecond)
+    {
+        auto averagingTime = 0.0;
+        auto decibelsPerSecond = 0.0;
+        
+        switch (ballistics)
+        {
+            case AnalyzerBallistics::raw: break;
+            case AnalyzerBallistics::fast: averagingTime = 0.125; break;
+            case AnalyzerBallistics::slow: averagingTime = 1.0; break;
+            case AnalyzerBallistics::peakHold: averagingTime = 0.125; decibelsPerSecond = 12.0; break;
+        }
+        
+        smoothing = averagingTime > 0.0 ? (float)(1.0 - std::exp(-1.0 / (averagingTime * framesPerSecond))) : 1.f;
+        
+        // no hold at all is a decay so big the peak can never stay above the average
+        peakDecay = decibelsPerSecond > 0.0 ? (float)(decibelsPerSecond / framesPerSecond) : std::numeric_limits<float>::max();
+    }
+    
+    // dest can be complexBins itself
+    void process(float* dest, const float* complexBins, float scale, float negativeInfinity)
+    {
+        kernels->processSpectrum(dest, average.data(), peak.data(), complexBins, (int)average.size(),
+                                 scale, negativeInfinity, smoothing, peakDecay);
+    }
+private:
+    std::vector<float> average, peak;
+    float smoothing = 1.f;
+    float peakDecay = std::numeric_limits<float>::max();
+    
+    const DSPKernels::KernelTable* kernels = &DSPKernels::getKernels();
+};
+
 template<typename BlockType>
 struct FFTDataGenerator
 {
+    explicit FFTDataGenerator(FFTOrder initialOrder = FFTOrder::order2048) :
+    plan(makePlan(initialOrder)),
+    requestedOrder(initialOrder)
+    {
+    }
+    
     /**
-     produces the FFT data from an audio buffer.
+     produces the FFT data from a circular history of fftSize samples, the oldest of which is at oldestIndex.
      */
-    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    void produceFFTDataForRendering(const float* history, int oldestIndex, const float negativeInfinity)
     {
         const auto fftSize = getFFTSize();
-        
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
-        
-        // first apply a windowing function to our data
-        window->multiplyWithWindowingTable (fftData.data(), fftSize);       // [1]
+        jassert( oldestIndex >= 0 && oldestIndex < fftSize );
+
+        // the FFT is done right inside the fifo slot, if the consumer is behind there's no point doing it at all
+        auto* fftData = plan->fftDataFifo.beginWrite();
+        if( fftData == nullptr )
+            return;
+
+        // first apply a windowing function to our data, straight from the history into the slot.
+        // the history wraps around, so it goes in two pieces: oldest..end, then start..oldest
+        const auto* window = plan->window.data();
+        const auto numToEnd = fftSize - oldestIndex;
+        kernels->applyWindow(fftData->data(), history + oldestIndex, window, numToEnd);
+        kernels->applyWindow(fftData->data() + numToEnd, history, window + numToEnd, oldestIndex);
         
         // then render our FFT data..
-        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());  // [2]
+        plan->forwardFFT.performRealOnlyForwardTransform(fftData->data(), true);
         
         int numBins = (int)fftSize / 2;
         
-        //normalize the fft values.
-        for( int i = 0; i < numBins; ++i )
-        {
-            fftData[i] /= (float) numBins;
-        }
-        
-        //convert them to decibels
-        for( int i = 0; i < numBins; ++i )
-        {
-            fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-        }
+        //normalize the fft values, convert them to decibels and apply the ballistics in one pass
+        plan->spectrum.process(fftData->data(), fftData->data(), 1.f / (float)numBins, negativeInfinity);
         
-        fftDataFifo.push(fftData);
+        plan->fftDataFifo.finishedWrite();
     }
     
+    /*
+     asks for a different order, from any thread. nothing changes straight away: the FFT, window and
+     fifo for the new order get built on a background thread while the current ones carry on,
+     and the next updateOrder() after that's done swaps them in.
+     */
     void changeOrder(FFTOrder newOrder)
     {
-        //when you change order, recreate the window, forwardFFT, fifo, fftData
-        //also reset the fifoIndex
-        //things that need recreating should be created on the heap via std::make_unique<>
+        requestedOrder.store(newOrder);
+    }
+    
+    /*
+     call this from the thread that produces and reads the FFT data, before doing either.
+     returns true if a new order has just been swapped in, in which case the FFT size has changed
+     and any FFT data that was still waiting is gone with the old fifo.
+     */
+    bool updateOrder()
+    {
+        auto swapped = false;
         
-        order = newOrder;
-        auto fftSize = getFFTSize();
+        if( pendingPlan.valid() )
+        {
+            if( pendingPlan.wait_for(std::chrono::seconds(0)) != std::future_status::ready )
+                return false;
+            
+            plan = pendingPlan.get();
+            swapped = true;
+        }
         
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
+        // the order may have been changed again while that one was being built
+        auto wanted = requestedOrder.load();
+        if( plan->order != wanted )
+            pendingPlan = std::async(std::launch::async, [wanted] { return makePlan(wanted); });
         
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
+        return swapped;
     }
+    // both of these are for the thread doing the producing, same as updateOrder()
+    void setBallistics(AnalyzerBallistics ballistics, double framesPerSecond) { plan->spectrum.setBallistics(ballistics, framesPerSecond); }
+    void resetBallistics(float negativeInfinity) { plan->spectrum.reset(negativeInfinity); }
     //==============================================================================
-    int getFFTSize() const { return 1 << order; }
-    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
+    FFTOrder getOrder() const { return plan->order; }
+    int getFFTSize() const { return 1 << plan->order; }
+    int getNumAvailableFFTDataBlocks() const { return plan->fftDataFifo.getNumAvailableForReading(); }
     //==============================================================================
-    bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
+    // the oldest block of FFT data, read in place. hand it back with finishedReadingFFTData()
+    const BlockType* getNextFFTData() { return plan->fftDataFifo.beginRead(); }
+    void finishedReadingFFTData() { plan->fftDataFifo.finishedRead(); }
 private:
-    FFTOrder order;
-    BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    // everything whose size depends on the order, so it can be built elsewhere and swapped in as one
+    struct Plan
+    {
+        Plan(FFTOrder newOrder, float negativeInfinity) :
+        order(newOrder),
+        forwardFFT(newOrder),
+        window((size_t)(1 << newOrder))
+        {
+            juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), window.size(),
+                                                                     juce::dsp::WindowingFunction<float>::blackmanHarris);
+            
+            // every slot doubles as the FFT's workspace, which needs room for 2 * fftSize floats
+            fftDataFifo.prepare(window.size() * 2);
+            
+            spectrum.prepare((int)window.size() / 2, negativeInfinity);
+        }
+        
+        const FFTOrder order;
+        juce::dsp::FFT forwardFFT;
+        std::vector<float> window;
+        SpectrumProcessor spectrum;
+        Fifo<BlockType> fftDataFifo;
+    };
+    
+    // the averages of a fresh plan start out at the same floor the analyzer draws with
+    static std::unique_ptr<Plan> makePlan(FFTOrder newOrder) { return std::make_unique<Plan>(newOrder, -48.f); }
+    
+    std::unique_ptr<Plan> plan;
+    std::future<std::unique_ptr<Plan>> pendingPlan;
+    std::atomic<FFTOrder> requestedOrder;
     
-    Fifo<BlockType> fftDataFifo;
+    const DSPKernels::KernelTable* kernels = &DSPKernels::getKernels();
+};
+
+/*
+ one channel's analyzer trace, ready to draw: at most one point per pixel column, already in the
+ coordinates of the analysis area. points only ever grows, so once it has room for the width
+ nothing gets allocated from one frame to the next. only the first numPoints are valid.
+ */
+struct AnalyzerTrace
+{
+    std::vector<juce::Point<float>> points;
+    int numPoints = 0;
+};
+
+// one band's newest spectrum, as handed to AnalyzerPathGenerator
+struct AnalyzerSpectrum
+{
+    const float* levels = nullptr;
+    int numBins = 0;
+    float binWidth = 0.f;
 };
 
-template<typename PathType>
 struct AnalyzerPathGenerator
 {
     /*
-     converts 'renderData[]' into a juce::Path
+     converts a spectrum into the points of 'trace', with one point per pixel column at most.
+     all the bins that land in the same column are collapsed into the loudest of them.
+     if there's a low band, everything below 'crossover' comes from that instead of the full band.
      */
-    void generatePath(const std::vector<float>& renderData,
+    void generatePath(const AnalyzerSpectrum& fullBand,
+                      const AnalyzerSpectrum& lowBand,
+                      float crossover,
                       juce::Rectangle<float> fftBounds,
-                      int fftSize,
-                      float binWidth,
-                      float negativeInfinity)
+                      float negativeInfinity,
+                      AnalyzerTrace& trace)
     {
         auto top = fftBounds.getY();
-        auto bottom = fftBounds.getHeight();
+        auto bottom = fftBounds.getBottom();
+        auto left = fftBounds.getX();
         auto width = fftBounds.getWidth();
 
-        int numBins = (int)fftSize / 2;
+        MapKey key { width, fullBand.numBins, fullBand.binWidth, lowBand.levels != nullptr ? lowBand.numBins : 0, lowBand.binWidth, crossover };
+        if( ! (key == mappedKey) )
+            buildColumnMap(key);
 
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        // only grows when the component does
+        if( trace.points.size() < columns.size() )
+            trace.points.resize(columns.size());
 
         auto map = [bottom, top, negativeInfinity](float v)
         {
             return juce::jmap(v,
                               negativeInfinity, 0.f,
-                              float(bottom),   top);
+                              bottom,   top);
         };
 
-        auto y = map(renderData[0]);
+        const float* bands[] = { fullBand.levels, lowBand.levels };
+        auto* points = trace.points.data();
+        int numPoints = 0;
 
-        jassert( !std::isnan(y) && !std::isinf(y) );
+        for( const auto& column : columns )
+        {
+            auto level = juce::FloatVectorOperations::findMaximum(bands[column.band] + column.firstBin, column.numBins);
+            auto y = map(level);
 
-        p.startNewSubPath(0, y);
+            jassert( !std::isnan(y) && !std::isinf(y) );
 
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
+            if( !std::isnan(y) && !std::isinf(y) )
+                points[numPoints++] = { left + column.x, y };
+        }
+
+        trace.numPoints = numPoints;
+    }
+private:
+    // a run of bins from one band that all land in the same pixel column
+    struct ColumnBins
+    {
+        float x;
+        int band;
+        int firstBin;
+        int numBins;
+    };
 
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
+    // everything the column map depends on
+    struct MapKey
+    {
+        float width = 0.f;
+        int numBins = 0;
+        float binWidth = 0.f;
+        int numLowBandBins = 0;
+        float lowBandBinWidth = 0.f;
+        float crossover = 0.f;
+
+        bool operator==(const MapKey& other) const
         {
-            y = map(renderData[binNum]);
+            return width == other.width && numBins == other.numBins && binWidth == other.binWidth
+                && numLowBandBins == other.numLowBandBins && lowBandBinWidth == other.lowBandBinWidth
+                && crossover == other.crossover;
+        }
+    };
 
-            jassert( !std::isnan(y) && !std::isinf(y) );
+    std::vector<ColumnBins> columns;
+    MapKey mappedKey;
 
-            if( !std::isnan(y) && !std::isinf(y) )
+    // which bins end up in which column only changes with the width, the FFT sizes or the sample rate
+    void buildColumnMap(const MapKey& key)
+    {
+        mappedKey = key;
+
+        const int numColumns = (int)key.width;
+
+        columns.clear();
+        columns.reserve((size_t)juce::jmax(0, numColumns));
+
+        // DC is left out, anything below 20Hz is piled into the first column
+        auto addBins = [this, &key, numColumns](int band, int numBins, float binWidth, float minFreq, float maxFreq)
+        {
+            for( int binNum = 1; binNum < numBins; ++binNum )
             {
                 auto binFreq = binNum * binWidth;
+                if( binFreq < minFreq )
+                    continue;
+
                 auto normalizedBinX = juce::mapFromLog10(binFreq, 20.f, 20000.f);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
+                int binX = juce::jmax(0, (int)std::floor(normalizedBinX * key.width));
+
+                // the bins only ever move right, so everything from here on is past 20kHz or the crossover
+                if( binX >= numColumns || binFreq >= maxFreq )
+                    break;
+
+                if( ! columns.empty() && (int)columns.back().x == binX )
+                {
+                    // a column the low band has already covered stays with the low band
+                    if( columns.back().band == band )
+                        ++columns.back().numBins;
+                }
+                else
+                {
+                    columns.push_back({ (float)binX, band, binNum, 1 });
+                }
             }
-        }
+        };
 
-        pathFifo.push(p);
+        if( key.numLowBandBins > 0 )
+        {
+            addBins(1, key.numLowBandBins, key.lowBandBinWidth, 0.f, key.crossover);
+            addBins(0, key.numBins, key.binWidth, key.crossover, std::numeric_limits<float>::max());
+        }
+        else
+        {
+            addBins(0, key.numBins, key.binWidth, 0.f, std::numeric_limits<float>::max());
+        }
     }
+};
 
-    int getNumPathsAvailable() const
-    {
-        return pathFifo.getNumAvailableForReading();
-    }
+/*
+ one short-time Fourier transform over a stream of samples: a circular history of the last fftSize
+ samples, a frame every hop, and the FFTDataGenerator that turns each frame into a spectrum.
+ apart from the generator's changeOrder() all of this belongs to the analyzer thread.
+ */
+struct AnalyzerBand
+{
+    explicit AnalyzerBand(FFTOrder initialOrder = FFTOrder::order2048);
 
-    bool getPath(PathType& path)
-    {
-        return pathFifo.pull(path);
-    }
+    // back to silence, with the averages and peaks back at the floor
+    void reset();
+
+    // swaps in a new FFT order once it's been built, and the history with it. true if it did
+    bool updateOrder();
+
+    // the hop in this band's own samples, and how many frames a second that makes for the ballistics
+    void setHop(int newHopSize, AnalyzerBallistics ballistics, double framesPerSecond);
+
+    void push(const float* samples, int numSamples);
+
+    // copies the newest spectrum into 'spectrum' and hands back every frame. false if there wasn't a new one
+    bool copyNewestSpectrum(std::vector<float>& spectrum);
+
+    FFTDataGenerator<std::vector<float>> generator;
 private:
-    Fifo<PathType> pathFifo;
+    // the last fftSize samples, written circularly so nothing ever gets shifted along
+    juce::AudioBuffer<float> history;
+    int writePosition = 0;
+    int samplesSinceLastFrame = 0;
+    int hopSize = 1;
 };
 
-
 struct LookAndFeel : juce::LookAndFeel_V4
 {
     void drawRotarySlider (juce::Graphics&,
@@ -169,6 +419,8 @@ struct LookAndFeel : juce::LookAndFeel_V4
                            bool shouldDrawButtonAsHighlighted,
                            bool shouldDrawButtonAsDown) override;
     
+    // the knobs and power buttons are drawn once per frame into here and blitted from then on
+    juce::SharedResourcePointer<FilmstripCache> filmstrips;
 };
 
 struct RotarySliderWithLabels : juce::Slider
@@ -195,6 +447,7 @@ struct RotarySliderWithLabels : juce::Slider
     juce::Array<LabelPos> labels;
     
     void paint(juce::Graphics& g) override;
+    void resized() override;
     juce::Rectangle<int> getSliderbounds() const;
     int getTextHeight() const { return 14; }
     juce::String getDisplayString() const;
@@ -202,30 +455,122 @@ private:
     LookAndFeel lnf;
     juce::RangedAudioParameter* param;
     juce::String suffix;
+    
+    // the labels around the knob never move, so they're laid out and drawn once per size
+    Filmstrip labelRing;
 };
 
 struct PathProducer
 {
     PathProducer(SingleChannelSampleFifo<SSimpleEQAudioProcessor::BlockType>& scsf) : leftChannelFifo(&scsf)
     {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
     }
     
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+    // analyzer thread: drains the fifo, does the FFTs and publishes the newest path. false if the fifo was empty
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate);
+    
+    // any thread: whether there's captured audio waiting for process()
+    bool hasPendingAudio() const { return leftChannelFifo->getNumCompleteBuffersAvailable() > 0; }
+    
+    // message thread: picks up the newest published trace, returns true if there was a new one
+    bool updateTrace() { return publishedTraces.update(); }
+    const AnalyzerTrace& getTrace() const { return publishedTraces.getReadBuffer(); }
+    
+    // takes effect once the new FFT has been built in the background, safe to call from any thread
+    void setFFTOrder(FFTOrder newOrder) { fullBand.generator.changeOrder(newOrder); }
+    
+    /*
+     multi-resolution: the bottom of the spectrum also gets decimated by 4 and analysed with an FFT of
+     its own, which is then stitched under the full band one. with a 2048 point FFT that's the bass
+     resolution of an 8192 point one for about a quarter more than the 2048 alone costs.
+     */
+    void setMultiResolution(bool shouldUseLowBand) { multiResolution.store(shouldUseLowBand); }
+    
+    void setBallistics(AnalyzerBallistics newBallistics) { ballistics.store(newBallistics); }
+    
+    void setOverlap(FFTOverlap newOverlap) { overlap.store(newOverlap); }
+    FFTOverlap getOverlap() const { return overlap.load(); }
+    int getHopSize() const;
     
 private:
     SingleChannelSampleFifo<SSimpleEQAudioProcessor::BlockType>* leftChannelFifo;
     
-    juce::AudioBuffer<float> monoBuffer;
+    // 75% keeps frames coming at least as often as the display can show them
+    std::atomic<FFTOverlap> overlap { FFTOverlap::threeQuarters };
+    std::atomic<AnalyzerBallistics> ballistics { AnalyzerBallistics::fast };
+    std::atomic<bool> multiResolution { false };
+    
+    AnalyzerBand fullBand;
+    
+    // two half-band stages down to a quarter of the sample rate, then the same FFT size as the full band
+    struct LowBand
+    {
+        static constexpr int decimation = 4;
+        
+        std::array<HalfBandDecimator, 2> decimators;
+        AnalyzerBand band;
+        
+        // the incoming blocks get decimated this much at a time
+        std::array<float, 256> scratch;
+        
+        // the low band's frames come in on their own schedule, so the newest one is kept for stitching
+        std::vector<float> spectrum;
+    };
+    
+    // only exists while multi-resolution is on
+    std::unique_ptr<LowBand> lowBand;
+    
+    void pushToLowBand(const float* samples, int numSamples);
+    
+    AnalyzerPathGenerator pathProducer;
     
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
+    // every buffer keeps its points from frame to frame, so publishing never allocates
+    TripleBuffer<AnalyzerTrace> publishedTraces;
     
-    AnalyzerPathGenerator<juce::Path> pathProducer;
+    /*
+     a copy of the last trace that went out. a trace that hasn't moved by at least
+     traceChangeThreshold pixels anywhere isn't published, so a static spectrum lets the editor go idle
+     */
+    AnalyzerTrace lastPublishedTrace;
+    static constexpr float traceChangeThreshold = 0.5f;
     
-    juce::Path leftChannelFFTPath;
+    void publishTraceIfChanged();
+};
+
+/*
+ runs the whole analyzer for the response curve off the message thread: fifo draining, FFTs,
+ decibels and path generation. while audio keeps arriving it does one round every intervalMs on its
+ own schedule, however often the editor happens to be repainting, and the message thread just picks
+ up whatever paths the producers have published since it last looked.
+ after a round that found nothing to read it sleeps until notify()d, the editor's timer does that
+ as soon as it sees captured audio waiting.
+ */
+struct AnalyzerThread : juce::Thread
+{
+    AnalyzerThread(PathProducer& left, PathProducer& right);
+    ~AnalyzerThread() override;
+    
+    void setAnalysisArea(juce::Rectangle<float> newArea);
+    void setSampleRate(double newSampleRate) { sampleRate.store(newSampleRate); }
+    
+    // while it's not active the thread sleeps until it's made active again
+    void setActive(bool shouldBeActive);
+    
+    void run() override;
+    
+    /*
+     the capture fifo holds 30 blocks, which is 10ms of 32 sample blocks at 96kHz.
+     draining it twice as often as that keeps it from ever overflowing
+     */
+    static constexpr int intervalMs = 5;
+private:
+    PathProducer& leftPathProducer;
+    PathProducer& rightPathProducer;
     
+    juce::SpinLock areaLock;
+    juce::Rectangle<float> analysisArea;
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<bool> active { true };
 };
 
 struct ResponseCurveComponent : juce::Component,
@@ -242,18 +587,79 @@ juce::Timer
     void paint(juce::Graphics& g) override;
     void resized() override;
     
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
-    
 private:
     SSimpleEQAudioProcessor& audioProcessor;
-    juce::Atomic<bool> parametersChanged { false };
-    MonoChain monoChain;
     
-    void updateChain();
-    juce::Image background;
+    static constexpr int numBands = 3;
+    static constexpr int allBands = (1 << numBands) - 1;
+    
+    // one bit per ChainPositions for every band whose parameters changed, set from whichever thread changed them
+    std::atomic<int> parametersChanged { 0 };
+    
+    // the band each of the processor's parameters belongs to, by parameter index. -1 if it isn't part of a filter
+    std::vector<int> parameterBands;
+    
+    MonoChain<float> monoChain;
+    
+    void updateChain(int changedBands);
+    
+    /*
+     each band keeps its own magnitude in dB for every pixel column, so a change to one band doesn't
+     mean working out the others again. the curve that gets drawn is the sum of the three, and paint
+     only has to stroke it.
+     */
+    std::array<std::vector<float>, numBands> bandMagnitudes;
+    juce::Path responseCurve;
+    double curveSampleRate = 0.0;
+    
+    // the columns' frequencies, with their trig worked out once per resize or sample rate change
+    FrequencyResponseEvaluator responseEvaluator;
+    void updateResponseGrid();
+    
+    void updateBandMagnitudes(int band);
+    void updateResponseCurve(int changedBands);
+    
+    /*
+     the grid and its labels, drawn at the display's physical scale so they stay sharp on HiDPI screens.
+     there's one layer per scale it's been painted at, for moving between screens. after a resize the
+     newest one gets stretched until the size has settled for backgroundRebuildDelayMs, then the timer
+     draws a new one.
+     */
+    struct BackgroundLayer
+    {
+        juce::Image image;
+        juce::Rectangle<int> bounds;
+        float scale;
+    };
+    
+    static constexpr size_t maxBackgroundLayers = 3;
+    static constexpr juce::uint32 backgroundRebuildDelayMs = 150;
+    
+    std::vector<BackgroundLayer> backgroundLayers;
+    float paintScale = 1.f;
+    bool backgroundOutOfDate = false;
+    juce::uint32 lastResizeTime = 0;
+    
+    // the layer for the current size and scale, if there is one
+    const BackgroundLayer* findBackgroundLayer() const;
+    void rebuildBackground();
+    void drawBackground(juce::Graphics& g);
+    
+    /*
+     the timer only repaints when there's a new analyzer trace or the curve changed. it also slows itself
+     down, to idleFrameRate once nothing has changed for half a second, and towards minimumLoadedFrameRate
+     when frames start taking a noticeable part of their period to draw.
+     */
+    static constexpr int activeFrameRate = 60;
+    static constexpr int minimumLoadedFrameRate = 20;
+    static constexpr int idleFrameRate = 15;
+    
+    int frameRate = activeFrameRate;
+    int idleTicks = 0;
+    double frameCostMs = 0.0;
+    double paintCostMs = 0.0;
+    
+    void updateFrameRate(bool somethingChanged, double tickCostMs);
     
     juce::Rectangle<int> getRenderArea(); // Area in which the response curve and background will be drawn
     
@@ -261,19 +667,51 @@ private:
     
     PathProducer leftPathProducer, rightPathProducer;
     
+    // both traces get drawn through this one, so its storage is reused for every trace on every paint
+    juce::Path analyzerPath;
+    void drawAnalyzerTrace(juce::Graphics& g, const AnalyzerTrace& trace);
+    std::atomic<float>* analyzerResolution = nullptr;
+    std::atomic<float>* analyzerBallistics = nullptr;
+    std::atomic<float>* analyzerOverlap = nullptr;
+    std::atomic<float>* analyzerEnabled = nullptr;
+    
+    // declared after the producers so it's stopped before they go away
+    AnalyzerThread analyzerThread;
+    
     bool shouldShowFFTAnalysis = true;
     
+    // follows "Analyzer Enabled", whether the button, automation or a preset changed it
+    void toggleAnalysisEnablement(bool enabled)
+    {
+        shouldShowFFTAnalysis = enabled;
+        analyzerThread.setActive(enabled);
+        
+        // the traces have to appear or go away even if nothing else changes
+        repaint(getRenderArea());
+    }
+    
 };
 
 //==============================================================================
 
 struct PowerButton : juce::ToggleButton { };
+
+// the choices have to be in there before the attachment is made, so they're added straight from the parameter
+struct ParameterChoiceBox : juce::ComboBox
+{
+    ParameterChoiceBox(juce::AudioParameterChoice& choice)
+    {
+        addItemList(choice.choices, 1);
+    }
+};
+
 struct AnalyzerButton : juce::ToggleButton {
     void resized() override
     {
         auto bounds = getLocalBounds();
         auto insetRect = bounds.reduced(4);
         randomPath.clear();
+        filmstrip.clear();
         
         juce::Random r;
         
@@ -285,6 +723,9 @@ struct AnalyzerButton : juce::ToggleButton {
     }
     
     juce::Path randomPath;
+    
+    // off and on. the path is different for every button, so this one isn't shared
+    Filmstrip filmstrip;
 };
 
 
@@ -330,6 +771,8 @@ private:
     
     PowerButton lowCutBypassButton, peakBypassButton, highCutBypassButton;
     AnalyzerButton analyzerEnabledButton;
+    ParameterChoiceBox analyzerResolutionBox, analyzerBallisticsBox, analyzerOverlapBox;
+    ParameterChoiceBox filterModeBox, processingCoresBox;
     
     using ButtonAttachment = APVTS::ButtonAttachment;
     ButtonAttachment lowCutBypassButtonAttachment,
@@ -337,6 +780,12 @@ private:
                     highCutBypassButtonAttachment,
                     analyzerEnabledButtonAttachment;
     
+    APVTS::ComboBoxAttachment analyzerResolutionBoxAttachment,
+                            analyzerBallisticsBoxAttachment,
+                            analyzerOverlapBoxAttachment,
+                            filterModeBoxAttachment,
+                            processingCoresBoxAttachment;
+    
     std::vector<juce::Component*> getComps();
     
     LookAndFeel lnf;
@@ -9,6 +9,17 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // every parameter that feeds a filter band, i.e. not the analyzer or processing options
+    const char* const filterParameterIDs[] =
+    {
+        "LowCut Freq", "LowCut Slope", "LowCut Bypass",
+        "Peak Freq", "Peak Gain", "Peak Quality", "Peak Bypass",
+        "HighCut Freq", "HighCut Slope", "HighCut Bypass"
+    };
+}
+
 //==============================================================================
 SSimpleEQAudioProcessor::SSimpleEQAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -22,10 +33,19 @@ SSimpleEQAudioProcessor::SSimpleEQAudioProcessor()
                        )
 #endif
 {
+    for( auto* id : filterParameterIDs )
+        apvts.addParameterListener(id, this);
+    
+    apvts.addParameterListener("Processing Cores", this);
 }
 
 SSimpleEQAudioProcessor::~SSimpleEQAudioProcessor()
 {
+    for( auto* id : filterParameterIDs )
+        apvts.removeParameterListener(id, this);
+    
+    apvts.removeParameterListener("Processing Cores", this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -99,13 +119,42 @@ void SSimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
     spec.sampleRate = sampleRate;
     spec.numChannels = 1;
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    filterCascade.prepare(spec);
+    filterCascade.setKernels(DSPKernels::getKernels());
+    
+    auto numChannels = juce::jmin(juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()), BiquadCascade::maxChannels);
+    
+    // the double path runs the JUCE filters, one chain per channel
+    doubleChains.clear();
+    if( isUsingDoublePrecision() )
+    {
+        doubleChains.resize((size_t)numChannels);
+        
+        for( auto& chain : doubleChains )
+        {
+            initialiseCoefficients(chain);
+            chain.prepare(spec);
+        }
+    }
+    
+    // a task is a group of channels in float, a single channel in double.
+    // the workers only get started if multi-core processing is on
+    auto groupSize = isUsingDoublePrecision() ? 1 : filterCascade.getChannelGroupSize();
+    numWorkerTasks.store((numChannels + groupSize - 1) / groupSize);
+    updateWorkerPool();
     
+    // the designer is restarted around this so that prepare() is the only producer while it runs
+    coefficientDesigner.stopThread(1000);
+    coefficientDesigner.prepare(sampleRate);
     updateFilters();
+    coefficientDesigner.startThread();
     
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+   #if SSIMPLEEQ_FILTER_BENCHMARK
+    DBG(runFilterBenchmark(sampleRate, samplesPerBlock));
+   #endif
+    
+    analyzerFifo.prepare(samplesPerBlock);
+    analyzerWasCapturing = false;
     
     osc.initialise([](float x) { return std::sin(x); });
     osc.prepare(spec);
@@ -116,6 +165,28 @@ void SSimpleEQAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    coefficientDesigner.stopThread(1000);
+    
+    numWorkerTasks.store(0);
+    updateWorkerPool();
+}
+
+void SSimpleEQAudioProcessor::updateWorkerPool()
+{
+    // one worker per task beyond the one the audio thread does itself, if there are cores for it
+    auto numWorkers = 0;
+    if( processingCores->load() > 0.5f )
+        numWorkers = juce::jmax(0, juce::jmin(numWorkerTasks.load() - 1, juce::SystemStats::getNumCpus() - 1));
+    
+    const juce::SpinLock::ScopedLockType lock(workerPoolLock);
+    
+    if( numWorkers == workerPool.getNumWorkers() )
+        return;
+    
+    if( numWorkers > 0 )
+        workerPool.prepare(numWorkers);
+    else
+        workerPool.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -125,12 +196,10 @@ bool SSimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // anything from mono up to 64 channels works, e.g. 7.1.4, 3rd order ambisonics or a big immersive render.
+    // the cascade runs every channel through the same EQ, so the channel order doesn't matter.
+    auto numChannels = layouts.getMainOutputChannelSet().size();
+    if (numChannels < 1 || numChannels > BiquadCascade::maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -144,7 +213,8 @@ bool SSimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
 }
 #endif
 
-void SSimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template<typename SampleType>
+void SSimpleEQAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -155,28 +225,43 @@ void SSimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
     
     updateFilters();
  
-    juce::dsp::AudioBlock<float> block (buffer);
+    juce::dsp::AudioBlock<SampleType> block (buffer);
     
 //    buffer.clear();
 //    juce::dsp::ProcessContextReplacing<float> stereoContext(block);
 //    osc.process(stereoContext);
     
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
-    
-    juce::dsp::ProcessContextReplacing<float> leftContext (leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext (rightBlock);
+    filterCascade.setProcessingMode(static_cast<FilterProcessingMode>((int)filterMode->load()));
+    processFilters(block);
     
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    // nobody is looking at the analyzer, so there's nothing to capture for
+    auto shouldCapture = numAnalyzerConsumers.load() > 0 && analyzerEnabled->load() > 0.5f;
     
+    if( shouldCapture )
+    {
+        if( ! analyzerWasCapturing )
+            analyzerFifo.restart();
+        
+        analyzerFifo.update(buffer);
+    }
     
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    analyzerWasCapturing = shouldCapture;
     
     
 }
 
+void SSimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void SSimpleEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
 //==============================================================================
 bool SSimpleEQAudioProcessor::hasEditor() const
 {
@@ -202,88 +287,402 @@ void SSimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInB
     if(tree.isValid())
     {
         apvts.replaceState(tree);
-        updateFilters();
+        // the designer picks this up and the audio thread swaps the result in on a later block
+        coefficientDesigner.markAllBandsChanged();
     }
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+void SSimpleEQAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
-    ChainSettings settings;
+    // this can be called from any thread (including the audio thread for host automation),
+    // so it only flags the band. The redesign happens on the CoefficientDesigner thread.
+    juce::ignoreUnused(newValue);
     
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
+    if( parameterID.startsWith("LowCut") )
+        coefficientDesigner.bandChanged(ChainPositions::LowCut);
+    else if( parameterID.startsWith("Peak") )
+        coefficientDesigner.bandChanged(ChainPositions::Peak);
+    else if( parameterID.startsWith("HighCut") )
+        coefficientDesigner.bandChanged(ChainPositions::HighCut);
+    
+    // starting and stopping threads is no job for the audio thread
+    else if( parameterID == "Processing Cores" )
+        triggerAsyncUpdate();
+}
+
+ChainParameters::ChainParameters(juce::AudioProcessorValueTreeState& apvts) :
+lowCutFreq(apvts.getRawParameterValue("LowCut Freq")),
+highCutFreq(apvts.getRawParameterValue("HighCut Freq")),
+peakFreq(apvts.getRawParameterValue("Peak Freq")),
+peakGain(apvts.getRawParameterValue("Peak Gain")),
+peakQuality(apvts.getRawParameterValue("Peak Quality")),
+lowCutSlope(apvts.getRawParameterValue("LowCut Slope")),
+highCutSlope(apvts.getRawParameterValue("HighCut Slope")),
+lowCutBypass(apvts.getRawParameterValue("LowCut Bypass")),
+peakBypass(apvts.getRawParameterValue("Peak Bypass")),
+highCutBypass(apvts.getRawParameterValue("HighCut Bypass"))
+{
+}
+
+ChainSettings getChainSettings(const ChainParameters& params)
+{
+    ChainSettings settings;
     
-    settings.lowCutBypassed = apvts.getRawParameterValue("LowCut Bypass")->load() > 0.5f;
-    settings.peakBypassed = apvts.getRawParameterValue("Peak Bypass")->load() > 0.5f;
-    settings.highCutBypassed = apvts.getRawParameterValue("HighCut Bypass")->load() > 0.5f;
+    settings.lowCutFreq = params.lowCutFreq->load();
+    settings.highCutFreq = params.highCutFreq->load();
+    settings.peakFreq = params.peakFreq->load();
+    settings.peakGainDecibels = params.peakGain->load();
+    settings.peakQuality = params.peakQuality->load();
+    settings.lowCutSlope = static_cast<Slope>(params.lowCutSlope->load());
+    settings.highCutSlope = static_cast<Slope>(params.highCutSlope->load());
     
+    settings.lowCutBypassed = params.lowCutBypass->load() > 0.5f;
+    settings.peakBypassed = params.peakBypass->load() > 0.5f;
+    settings.highCutBypassed = params.highCutBypass->load() > 0.5f;
     
     return settings;
 }
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.peakFreq, chainSettings.peakQuality, juce::Decibels::decibelsToGain(chainSettings.peakGainDecibels));
+    return getChainSettings(ChainParameters(apvts));
 }
 
-
-void SSimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
+namespace
 {
-    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
+    /*
+     these mirror juce::dsp::IIR::Coefficients::makeHighPass / makeLowPass / makePeakFilter,
+     but write into a BiquadCoefficients instead of allocating a new Coefficients object.
+     */
+    BiquadCoefficients makeHighPassBiquad(double sampleRate, double frequency, double Q)
+    {
+        auto n = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        auto nSquared = n * n;
+        auto invQ = 1.0 / Q;
+        auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+        
+        return { c1, c1 * -2.0, c1, c1 * 2.0 * (nSquared - 1.0), c1 * (1.0 - invQ * n + nSquared) };
+    }
+    
+    BiquadCoefficients makeLowPassBiquad(double sampleRate, double frequency, double Q)
+    {
+        auto n = 1.0 / std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        auto nSquared = n * n;
+        auto invQ = 1.0 / Q;
+        auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+        
+        return { c1, c1 * 2.0, c1, c1 * 2.0 * (1.0 - nSquared), c1 * (1.0 - invQ * n + nSquared) };
+    }
     
-    leftChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    rightChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+    // same Q per stage as FilterDesign::designIIR...HighOrderButterworthMethod
+    double getButterworthQ(int stage, int order)
+    {
+        return 1.0 / (2.0 * std::cos((2.0 * stage + 1.0) * juce::MathConstants<double>::pi / (order * 2.0)));
+    }
+}
+
+BiquadCoefficients designPeakCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+    auto gain = juce::Decibels::decibelsToGain((double)chainSettings.peakGainDecibels);
+    auto A = juce::jmax(0.0, std::sqrt(gain));
+    auto omega = (juce::MathConstants<double>::twoPi * chainSettings.peakFreq) / sampleRate;
+    auto alpha = std::sin(omega) / (chainSettings.peakQuality * 2.0);
+    auto c2 = -2.0 * std::cos(omega);
+    auto alphaTimesA = alpha * A;
+    auto alphaOverA = alpha / A;
+    auto a0 = 1.0 / (1.0 + alphaOverA);
     
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    return { (1.0 + alphaTimesA) * a0, c2 * a0, (1.0 - alphaTimesA) * a0, c2 * a0, (1.0 - alphaOverA) * a0 };
 }
 
-void SSimpleEQAudioProcessor::updateLowCutFilters(const ChainSettings& chainSettings)
+void designLowCutCoefficients(CutCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate)
 {
-    // LOWCUT - GET COEFFICIENTS AND UPDATE FILTER PARAMS
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
+    auto order = 2 * (chainSettings.lowCutSlope + 1);
     
-    leftChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    rightChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+    for( int i = 0; i < order / 2; ++i )
+        coefficients[i] = makeHighPassBiquad(sampleRate, chainSettings.lowCutFreq, getButterworthQ(i, order));
+}
 
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    updateCutFilter(leftLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+void designHighCutCoefficients(CutCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate)
+{
+    auto order = 2 * (chainSettings.highCutSlope + 1);
+    
+    for( int i = 0; i < order / 2; ++i )
+        coefficients[i] = makeLowPassBiquad(sampleRate, chainSettings.highCutFreq, getButterworthQ(i, order));
+}
 
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-    updateCutFilter(rightLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+void SSimpleEQAudioProcessor::processFilters(const juce::dsp::AudioBlock<float>& block)
+{
+    const auto numChannels = juce::jmin((int)block.getNumChannels(), BiquadCascade::maxChannels);
+    const auto groupSize = filterCascade.getChannelGroupSize();
+    const auto numChannelGroups = (numChannels + groupSize - 1) / groupSize;
+    
+    // with the lock the workers can't be started or stopped under us until this block is done
+    const juce::SpinLock::ScopedTryLockType poolLock(workerPoolLock);
+    
+    if( ! poolLock.isLocked()
+       || workerPool.getNumWorkers() == 0
+       || numChannelGroups < 2
+       || (int)block.getNumSamples() < minSamplesForMultiCore )
+    {
+        filterCascade.process(block);
+        return;
+    }
+    
+    // every group has its own slice of the filter state, so they can run side by side
+    auto processGroup = [&](int group)
+    {
+        auto firstChannel = group * groupSize;
+        filterCascade.processChannels(block, firstChannel, juce::jmin(groupSize, numChannels - firstChannel));
+    };
+    
+    workerPool.run(numChannelGroups, processGroup);
 }
 
-void SSimpleEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings)
+void SSimpleEQAudioProcessor::processFilters(const juce::dsp::AudioBlock<double>& block)
 {
-    // HIGHCUT - GET COEFFICIENTS AND UPDATE FILTER PARAMS
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
+    const auto numChannels = juce::jmin((int)block.getNumChannels(), (int)doubleChains.size());
+    
+    auto processChannel = [&](int channel)
+    {
+        auto channelBlock = block.getSingleChannelBlock((size_t)channel);
+        doubleChains[(size_t)channel].process(juce::dsp::ProcessContextReplacing<double>(channelBlock));
+    };
     
-    leftChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    rightChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    const juce::SpinLock::ScopedTryLockType poolLock(workerPoolLock);
     
-    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    if( ! poolLock.isLocked()
+       || workerPool.getNumWorkers() == 0
+       || numChannels < 2
+       || (int)block.getNumSamples() < minSamplesForMultiCore )
+    {
+        for( int channel = 0; channel < numChannels; ++channel )
+            processChannel(channel);
+        
+        return;
+    }
     
-    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    workerPool.run(numChannels, processChannel);
 }
 
 void SSimpleEQAudioProcessor::updateFilters()
 {
-    auto chainSettings = getChainSettings(apvts);
-    updateLowCutFilters(chainSettings);
-    updatePeakFilter(chainSettings);
-    updateHighCutFilters(chainSettings);
+    // just swaps in the latest published set, all the designing happened on the designer thread
+    if( ! coefficientDesigner.pullLatestCoefficients() )
+        return;
+    
+    const auto& coefficientSet = coefficientDesigner.getLatestCoefficients();
+    filterCascade.setCoefficients(coefficientSet);
+    
+    for( auto& chain : doubleChains )
+        applyCoefficients(chain, coefficientSet);
 }
 
-void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+
+//==============================================================================
+CoefficientDesigner::CoefficientDesigner(const ChainParameters& params) :
+juce::Thread("SSimpleEQ Coefficient Designer"),
+chainParameters(params)
 {
-    *old = *replacements;
+}
+
+CoefficientDesigner::~CoefficientDesigner()
+{
+    stopThread(1000);
+}
+
+void CoefficientDesigner::prepare(double sampleRate)
+{
+    jassert( ! isThreadRunning() );
+    
+    currentSampleRate = sampleRate;
+    markAllBandsChanged();
+    
+    designChangedBands();
+    publish();
+}
+
+void CoefficientDesigner::bandChanged(ChainPositions band)
+{
+    changedBands[band].set(true);
+    notify();
+}
+
+void CoefficientDesigner::markAllBandsChanged()
+{
+    for( auto& changed : changedBands )
+        changed.set(true);
+    
+    notify();
+}
+
+void CoefficientDesigner::run()
+{
+    while( ! threadShouldExit() )
+    {
+        if( designChangedBands() )
+            publish();
+        
+        // sleeps until bandChanged() notifies, a notify that arrives while designing isn't lost
+        wait(-1);
+    }
+}
+
+bool CoefficientDesigner::designChangedBands()
+{
+    auto lowCutChanged = changedBands[ChainPositions::LowCut].compareAndSetBool(false, true);
+    auto peakChanged = changedBands[ChainPositions::Peak].compareAndSetBool(false, true);
+    auto highCutChanged = changedBands[ChainPositions::HighCut].compareAndSetBool(false, true);
+    
+    if( ! (lowCutChanged || peakChanged || highCutChanged) )
+        return false;
+    
+    auto chainSettings = getChainSettings(chainParameters);
+    
+    if( lowCutChanged )
+    {
+        designLowCutCoefficients(current.lowCut, chainSettings, currentSampleRate);
+        current.lowCutSlope = chainSettings.lowCutSlope;
+        current.lowCutBypassed = chainSettings.lowCutBypassed;
+    }
+    
+    if( peakChanged )
+    {
+        current.peak = designPeakCoefficients(chainSettings, currentSampleRate);
+        current.peakBypassed = chainSettings.peakBypassed;
+    }
+    
+    if( highCutChanged )
+    {
+        designHighCutCoefficients(current.highCut, chainSettings, currentSampleRate);
+        current.highCutSlope = chainSettings.highCutSlope;
+        current.highCutBypassed = chainSettings.highCutBypassed;
+    }
+    
+    return true;
+}
+
+void CoefficientDesigner::publish()
+{
+    coefficientBuffer.getWriteBuffer() = current;
+    coefficientBuffer.publish();
+}
+
+juce::String runFilterBenchmark(double sampleRate, int blockSize)
+{
+    juce::ScopedNoDenormals noDenormals;
+    
+    // worst case, every stage of every band is running
+    ChainSettings settings;
+    settings.lowCutFreq = 80.f;
+    settings.highCutFreq = 12000.f;
+    settings.peakFreq = 750.f;
+    settings.peakGainDecibels = 6.f;
+    settings.peakQuality = 1.f;
+    settings.lowCutSlope = Slope::Slope_48;
+    settings.highCutSlope = Slope::Slope_48;
+    
+    FilterCoefficientSet coefficientSet;
+    designLowCutCoefficients(coefficientSet.lowCut, settings, sampleRate);
+    coefficientSet.peak = designPeakCoefficients(settings, sampleRate);
+    designHighCutCoefficients(coefficientSet.highCut, settings, sampleRate);
+    coefficientSet.lowCutSlope = settings.lowCutSlope;
+    coefficientSet.highCutSlope = settings.highCutSlope;
+    
+    juce::AudioBuffer<float> noise(2, blockSize), buffer(2, blockSize);
+    juce::Random random;
+    for( int ch = 0; ch < 2; ++ch )
+        for( int i = 0; i < blockSize; ++i )
+            noise.setSample(ch, i, random.nextFloat() * 2.f - 1.f);
+    
+    juce::AudioBuffer<double> doubleNoise, doubleBuffer(2, blockSize);
+    doubleNoise.makeCopyOf(noise);
+    
+    const int numBlocks = juce::jmax(1, juce::roundToInt(sampleRate * 10.0 / blockSize));
+    
+    // returns milliseconds of cpu time per second of audio
+    auto time = [&](const auto& source, auto& target, auto&& processBlock)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        
+        for( int n = 0; n < numBlocks; ++n )
+        {
+            target.makeCopyOf(source, true);
+            processBlock(target);
+        }
+        
+        auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1000.0 / 10.0;
+    };
+    
+    juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32)blockSize, 1 };
+    
+    auto prepareChain = [&](auto& chain)
+    {
+        initialiseCoefficients(chain);
+        chain.prepare(spec);
+        applyCoefficients(chain, coefficientSet);
+    };
+    
+    MonoChain<float> leftChain, rightChain;
+    prepareChain(leftChain);
+    prepareChain(rightChain);
+    
+    auto juceFilterTime = time(noise, buffer, [&](juce::AudioBuffer<float>& target)
+    {
+        juce::dsp::AudioBlock<float> block(target);
+        auto leftBlock = block.getSingleChannelBlock(0);
+        auto rightBlock = block.getSingleChannelBlock(1);
+        leftChain.process(juce::dsp::ProcessContextReplacing<float>(leftBlock));
+        rightChain.process(juce::dsp::ProcessContextReplacing<float>(rightBlock));
+    });
+    
+    MonoChain<double> leftDoubleChain, rightDoubleChain;
+    prepareChain(leftDoubleChain);
+    prepareChain(rightDoubleChain);
+    
+    auto juceDoubleFilterTime = time(doubleNoise, doubleBuffer, [&](juce::AudioBuffer<double>& target)
+    {
+        juce::dsp::AudioBlock<double> block(target);
+        auto leftBlock = block.getSingleChannelBlock(0);
+        auto rightBlock = block.getSingleChannelBlock(1);
+        leftDoubleChain.process(juce::dsp::ProcessContextReplacing<double>(leftBlock));
+        rightDoubleChain.process(juce::dsp::ProcessContextReplacing<double>(rightBlock));
+    });
+    
+    BiquadCascade cascade;
+    cascade.prepare(spec);
+    cascade.setCoefficients(coefficientSet);
+    
+    auto timeCascade = [&](BiquadCascade::ProcessingMode mode)
+    {
+        cascade.reset();
+        cascade.setProcessingMode(mode);
+        return time(noise, buffer, [&](juce::AudioBuffer<float>& target) { cascade.process(juce::dsp::AudioBlock<float>(target)); });
+    };
+    
+    juce::String report;
+    report << "filter benchmark, " << sampleRate << " Hz, " << blockSize << " samples per block, 9 stages, stereo\n";
+    report << "  juce::dsp::IIR::Filter MonoChains, float:  " << juce::String(juceFilterTime, 3) << " ms per second of audio\n";
+    report << "  juce::dsp::IIR::Filter MonoChains, double: " << juce::String(juceDoubleFilterTime, 3) << " ms per second of audio";
+    
+    using DSPKernels::InstructionSet;
+    for( auto instructionSet : { InstructionSet::generic, InstructionSet::sse2, InstructionSet::avx2, InstructionSet::avx512 } )
+    {
+        if( ! DSPKernels::isSupported(instructionSet) )
+            continue;
+        
+        cascade.setKernels(DSPKernels::getKernels(instructionSet));
+        
+        auto perSampleTime = timeCascade(BiquadCascade::ProcessingMode::perSample);
+        auto blockStateSpaceTime = timeCascade(BiquadCascade::ProcessingMode::blockStateSpace);
+        
+        auto name = juce::String(DSPKernels::getName(instructionSet)).paddedRight(' ', 7);
+        report << "\n  cascade, " << name << " per sample:        " << juce::String(perSampleTime, 3) << " ms per second of audio";
+        report << "\n  cascade, " << name << " block state space: " << juce::String(blockStateSpaceTime, 3) << " ms per second of audio";
+    }
+    
+    return report;
 }
 
 
@@ -334,6 +733,40 @@ juce::AudioProcessorValueTreeState::ParameterLayout SSimpleEQAudioProcessor::cre
     layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{"Peak Bypass", 1}, "Peak Bypass", false));
     layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{"HighCut Bypass", 1}, "HighCut Bypass", false));
     layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{"Analyzer Enabled", 1}, "Analyzer Enabled", true));
+    
+    // the analyzer's FFT size, in the same order as FFTOrder in the editor, then multi-resolution
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Analyzer Resolution", 1},
+                                                            "Analyzer Resolution",
+                                                            juce::StringArray { "2048", "4096", "8192", "Multi-Res" },
+                                                            0));
+    
+    // how the analyzer trace moves, in the same order as AnalyzerBallistics in the editor
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Analyzer Ballistics", 1},
+                                                            "Analyzer Ballistics",
+                                                            juce::StringArray { "Raw", "Fast", "Slow", "Peak Hold" },
+                                                            1));
+    
+    // how much consecutive analyzer frames overlap, in the same order as FFTOverlap in the editor
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Analyzer Overlap", 1},
+                                                            "Analyzer Overlap",
+                                                            juce::StringArray { "No Overlap", "25% Overlap", "50% Overlap", "75% Overlap" },
+                                                            3));
+    
+    // how the cascade runs, in the same order as BiquadCascade::ProcessingMode. it sounds the same either way,
+    // so there's nothing for a host to automate. only the float path has the cascade, in double precision
+    // the MonoChain<double>s run whatever this says and the editor greys it out
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Filter Mode", 1},
+                                                            "Filter Mode",
+                                                            juce::StringArray { "Per Sample", "State Space" },
+                                                            0,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // whether big channel layouts get their channel groups spread over worker threads, see SSimpleEQAudioProcessor::workerPool
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"Processing Cores", 1},
+                                                            "Processing Cores",
+                                                            juce::StringArray { "Single Core", "Multi-Core" },
+                                                            0,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
         
     return layout;
 }
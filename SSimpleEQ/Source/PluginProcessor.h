@@ -11,7 +11,17 @@
 #include <JuceHeader.h>
 
 #include <array>
-template<typename T>
+#include "BiquadCascade.h"
+#include "ChannelWorkerPool.h"
+/*
+ single producer / single consumer ring of preallocated slots.
+ nothing is ever copied in or out: the producer reserves a slot, fills it in place and commits it,
+ the consumer reads (or swaps out of) the slot in place and then releases it.
+ so once the slots have been prepare()d, moving data through here never allocates.
+ one slot always stays empty, so at most Capacity - 1 items are in flight.
+ prepare() empties the ring as well, so neither side may be using it while that runs.
+ */
+template<typename T, int Capacity = 30>
 struct Fifo
 {
     void prepare(int numChannels, int numSamples)
@@ -27,6 +37,9 @@ struct Fifo
                            true);   //avoid reallocating if you can?
             buffer.clear();
         }
+        
+        // anything still waiting was the old size
+        fifo.reset();
     }
     
     void prepare(size_t numElements)
@@ -38,42 +51,111 @@ struct Fifo
             buffer.clear();
             buffer.resize(numElements, 0);
         }
+        
+        fifo.reset();
     }
     
-    bool push(const T& t)
+    // a run of reserved slots, in two pieces when it wraps around the end of the ring
+    struct Slots
     {
-        auto write = fifo.write(1);
-        if( write.blockSize1 > 0 )
-        {
-            buffers[write.startIndex1] = t;
-            return true;
-        }
+        T* block1 = nullptr;
+        int size1 = 0;
+        T* block2 = nullptr;
+        int size2 = 0;
         
-        return false;
+        int size() const { return size1 + size2; }
+        T& operator[](int index) const { return index < size1 ? block1[index] : block2[index - size1]; }
+    };
+    
+    // producer side: up to numItems free slots to fill in place, then commit however many were filled
+    Slots prepareToWrite(int numItems)
+    {
+        Slots slots;
+        int start1, start2;
+        fifo.prepareToWrite(numItems, start1, slots.size1, start2, slots.size2);
+        slots.block1 = buffers.data() + start1;
+        slots.block2 = buffers.data() + start2;
+        return slots;
     }
     
-    bool pull(T& t)
+    void finishedWrite(int numItems) { fifo.finishedWrite(numItems); }
+    
+    // consumer side: up to numItems ready slots to use in place, then release however many were used
+    Slots prepareToRead(int numItems)
     {
-        auto read = fifo.read(1);
-        if( read.blockSize1 > 0 )
-        {
-            t = buffers[read.startIndex1];
-            return true;
-        }
-        
-        return false;
+        Slots slots;
+        int start1, start2;
+        fifo.prepareToRead(numItems, start1, slots.size1, start2, slots.size2);
+        slots.block1 = buffers.data() + start1;
+        slots.block2 = buffers.data() + start2;
+        return slots;
+    }
+    
+    void finishedRead(int numItems) { fifo.finishedRead(numItems); }
+    
+    // one item at a time, nullptr when the ring is full / empty
+    T* beginWrite()
+    {
+        auto slots = prepareToWrite(1);
+        return slots.size() > 0 ? slots.block1 : nullptr;
+    }
+    
+    void finishedWrite() { finishedWrite(1); }
+    
+    T* beginRead()
+    {
+        auto slots = prepareToRead(1);
+        return slots.size() > 0 ? slots.block1 : nullptr;
     }
     
+    void finishedRead() { finishedRead(1); }
+    
     int getNumAvailableForReading() const
     {
         return fifo.getNumReady();
     }
 private:
-    static constexpr int Capacity = 30;
     std::array<T, Capacity> buffers;
     juce::AbstractFifo fifo {Capacity};
 };
 
+/*
+ single producer / single consumer handoff of the latest value.
+ the producer fills getWriteBuffer() and publish()es it, the consumer calls update() to swap
+ in whatever was published most recently. Neither side ever blocks or waits on the other,
+ and values that were published but never picked up are simply overwritten.
+ */
+template<typename T>
+struct TripleBuffer
+{
+    // producer side
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+    
+    void publish()
+    {
+        writeIndex = shared.exchange(writeIndex | freshBit) & indexMask;
+    }
+    
+    // consumer side, returns true if a new value was swapped in
+    bool update()
+    {
+        if( (shared.load() & freshBit) == 0 )
+            return false;
+        
+        readIndex = shared.exchange(readIndex) & indexMask;
+        return true;
+    }
+    
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+private:
+    static constexpr int freshBit = 4;
+    static constexpr int indexMask = 3;
+    
+    std::array<T, 3> buffers;
+    int writeIndex = 0, readIndex = 1;
+    std::atomic<int> shared { 2 };
+};
+
 enum Channel
 {
     Right, //effectively 0
@@ -88,68 +170,214 @@ struct SingleChannelSampleFifo
         prepared.set(false);
     }
     
-    void update(const BlockType& buffer)
+    // room left in the buffer being filled, write() never takes more than this at once
+    int getSpaceInCurrentBuffer() const { return size.get() - fifoIndex; }
+    
+    /*
+     copies one contiguous run into the buffer being filled, and hands it to the fifo as soon as it is full.
+     numSamples must not be more than getSpaceInCurrentBuffer().
+     */
+    template<typename SampleType>
+    void write(const SampleType* samples, int numSamples)
     {
-        jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse );
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(numSamples <= getSpaceInCurrentBuffer());
+        
+        // the ring was full when this buffer was due to start, see if the editor has caught up since
+        if (writeSlot == nullptr && fifoIndex == 0)
+            writeSlot = audioBufferFifo.beginWrite();
         
-        for( int i = 0; i < buffer.getNumSamples(); ++i )
+        if (writeSlot != nullptr)
         {
-            pushNextSampleIntoFifo(channelPtr[i]);
+            auto* dest = writeSlot->getWritePointer(0, fifoIndex);
+            
+            if constexpr (std::is_same_v<SampleType, float>)
+                juce::FloatVectorOperations::copy(dest, samples, numSamples);
+            else
+                for( int i = 0; i < numSamples; ++i )
+                    dest[i] = static_cast<float>(samples[i]);
+        }
+        
+        fifoIndex += numSamples;
+        
+        if (fifoIndex == size.get())
+        {
+            if (writeSlot != nullptr)
+                audioBufferFifo.finishedWrite();
+            
+            // if there's no room, the next buffer's worth of samples is dropped, just like a failed push was
+            writeSlot = audioBufferFifo.beginWrite();
+            
+            fifoIndex = 0;
         }
     }
 
+    /*
+     audio thread stopped, e.g. from prepareToPlay. the consumer may still be running though, and it
+     reads slots in place, so this waits for it to be out of them before they get resized. the ring
+     starts out empty and the consumer is told to restart, since the audio before this point doesn't
+     join up with what comes next.
+     */
     void prepare(int bufferSize)
     {
         prepared.set(false);
+        
+        resizing.set(true);
+        while( consumerActive.get() )
+            juce::Thread::yield();
+        
         size.set(bufferSize);
         
-        bufferToFill.setSize(1,             //channel
-                             bufferSize,    //num samples
-                             false,         //keepExistingContent
-                             true,          //clear extra space
-                             true);         //avoid reallocating
         audioBufferFifo.prepare(1, bufferSize);
+        writeSlot = audioBufferFifo.beginWrite();
         fifoIndex = 0;
+        restartCount.set(restartCount.get() + 1);
+        
+        resizing.set(false);
         prepared.set(true);
     }
+    
+    /*
+     audio thread: call when capture starts again after being switched off. the half filled buffer
+     is started over, and the consumer is told to throw away whatever it hasn't read yet.
+     */
+    void restart()
+    {
+        fifoIndex = 0;
+        restartCount.set(restartCount.get() + 1);
+    }
+    
+    /*
+     consumer: returns true once after every restart(), having dropped every buffer that was waiting.
+     a buffer captured just after the restart may go with them, which only delays the picture slightly.
+     */
+    bool checkForRestart()
+    {
+        if( ! beginConsuming() )
+            return false;
+        
+        auto count = restartCount.get();
+        auto restarted = count != lastSeenRestartCount;
+        
+        if( restarted )
+        {
+            lastSeenRestartCount = count;
+            audioBufferFifo.finishedRead(audioBufferFifo.getNumAvailableForReading());
+        }
+        
+        endConsuming();
+        return restarted;
+    }
     //==============================================================================
     int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
     bool isPrepared() const { return prepared.get(); }
     int getSize() const { return size.get(); }
     //==============================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
+    // the oldest complete buffer, read in place. hand it back with finishedReadingAudioBuffer()
+    const BlockType* getNextAudioBuffer()
+    {
+        if( ! beginConsuming() )
+            return nullptr;
+        
+        auto* buffer = audioBufferFifo.beginRead();
+        if( buffer == nullptr )
+            endConsuming();
+        
+        return buffer;
+    }
+    
+    void finishedReadingAudioBuffer()
+    {
+        audioBufferFifo.finishedRead();
+        endConsuming();
+    }
 private:
+    /*
+     the consumer holds this while it's in the ring, and backs off while prepare() is resizing.
+     each side sets its own flag before looking at the other's, so they can't both get in
+     */
+    bool beginConsuming()
+    {
+        consumerActive.set(true);
+        if( ! resizing.get() )
+            return true;
+        
+        consumerActive.set(false);
+        return false;
+    }
+    
+    void endConsuming() { consumerActive.set(false); }
+    
     Channel channelToUse;
     int fifoIndex = 0;
     Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
+    // the slot being filled, nullptr while the editor has fallen so far behind that the ring is full
+    BlockType* writeSlot = nullptr;
     juce::Atomic<bool> prepared = false;
     juce::Atomic<int> size = 0;
-    
-    void pushNextSampleIntoFifo(float sample)
+    juce::Atomic<int> restartCount = 0;
+    int lastSeenRestartCount = 0;
+    juce::Atomic<bool> consumerActive = false;
+    juce::Atomic<bool> resizing = false;
+};
+
+/*
+ captures both analyzer channels in one pass over each block.
+ the two fifos are always filled in lockstep, so every block is cut into runs at the same
+ buffer boundaries once and each run is copied over for both channels.
+ */
+template<typename BlockType>
+struct StereoSampleFifo
+{
+    template<typename SampleType>
+    void update(const juce::AudioBuffer<SampleType>& buffer)
     {
-        if (fifoIndex == bufferToFill.getNumSamples())
+        jassert(buffer.getNumChannels() > 0);
+        
+        // with no buffer size yet the loop below would never get anywhere
+        if( ! leftChannelFifo.isPrepared() || ! rightChannelFifo.isPrepared() )
+            return;
+        
+        // on a mono layout both analyzer channels show the one channel there is
+        auto lastChannel = buffer.getNumChannels() - 1;
+        auto* leftSamples = buffer.getReadPointer(juce::jmin((int)Channel::Left, lastChannel));
+        auto* rightSamples = buffer.getReadPointer(juce::jmin((int)Channel::Right, lastChannel));
+        
+        auto numSamples = buffer.getNumSamples();
+        
+        while( numSamples > 0 )
         {
-            auto ok = audioBufferFifo.push(bufferToFill);
-
-            juce::ignoreUnused(ok);
+            auto numToCopy = juce::jmin(numSamples,
+                                        leftChannelFifo.getSpaceInCurrentBuffer(),
+                                        rightChannelFifo.getSpaceInCurrentBuffer());
             
-            fifoIndex = 0;
+            leftChannelFifo.write(leftSamples, numToCopy);
+            rightChannelFifo.write(rightSamples, numToCopy);
+            
+            leftSamples += numToCopy;
+            rightSamples += numToCopy;
+            numSamples -= numToCopy;
         }
-        
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
     }
-};
-
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
+    
+    void prepare(int bufferSize)
+    {
+        leftChannelFifo.prepare(bufferSize);
+        rightChannelFifo.prepare(bufferSize);
+    }
+    
+    void restart()
+    {
+        leftChannelFifo.restart();
+        rightChannelFifo.restart();
+    }
+    
+    SingleChannelSampleFifo<BlockType>& getChannelFifo(Channel channel)
+    {
+        return channel == Channel::Left ? leftChannelFifo : rightChannelFifo;
+    }
+private:
+    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
+    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
 };
 
 struct ChainSettings
@@ -160,13 +388,37 @@ struct ChainSettings
     bool lowCutBypassed {false}, peakBypassed {false}, highCutBypassed {false};
 };
 
+/**
+ raw parameter pointers, looked up once so that reading the settings on the audio thread
+ doesn't have to build juce::Strings and search the apvts for every parameter.
+ */
+struct ChainParameters
+{
+    explicit ChainParameters(juce::AudioProcessorValueTreeState& apvts);
+    
+    std::atomic<float>* lowCutFreq { nullptr };
+    std::atomic<float>* highCutFreq { nullptr };
+    std::atomic<float>* peakFreq { nullptr };
+    std::atomic<float>* peakGain { nullptr };
+    std::atomic<float>* peakQuality { nullptr };
+    std::atomic<float>* lowCutSlope { nullptr };
+    std::atomic<float>* highCutSlope { nullptr };
+    std::atomic<float>* lowCutBypass { nullptr };
+    std::atomic<float>* peakBypass { nullptr };
+    std::atomic<float>* highCutBypass { nullptr };
+};
+
+ChainSettings getChainSettings(const ChainParameters& params);
 ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
 
-using Filter = juce::dsp::IIR::Filter<float>;
+template<typename SampleType>
+using Filter = juce::dsp::IIR::Filter<SampleType>;
 
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+template<typename SampleType>
+using CutFilter = juce::dsp::ProcessorChain<Filter<SampleType>, Filter<SampleType>, Filter<SampleType>, Filter<SampleType>>;
 
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+template<typename SampleType>
+using MonoChain = juce::dsp::ProcessorChain<CutFilter<SampleType>, Filter<SampleType>, CutFilter<SampleType>>;
 
 enum ChainPositions
 {
@@ -175,10 +427,99 @@ enum ChainPositions
     HighCut
 };
 
-using Coefficients = Filter::CoefficientsPtr;
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
+template<typename SampleType>
+using Coefficients = juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<SampleType>>;
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
+template<typename SampleType>
+void updateCoefficients(Coefficients<SampleType>& old, const Coefficients<SampleType>& replacements)
+{
+    *old = *replacements;
+}
+
+template<typename SampleType>
+Coefficients<SampleType> makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::IIR::Coefficients<SampleType>::makePeakFilter(sampleRate,
+                                                                    chainSettings.peakFreq,
+                                                                    chainSettings.peakQuality,
+                                                                    juce::Decibels::decibelsToGain((SampleType)chainSettings.peakGainDecibels));
+}
+
+BiquadCoefficients designPeakCoefficients(const ChainSettings& chainSettings, double sampleRate);
+void designLowCutCoefficients(CutCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate);
+void designHighCutCoefficients(CutCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate);
+
+// copies in place, the filter must already hold second order coefficients (see initialiseCoefficients)
+template<typename SampleType>
+void updateCoefficients(Coefficients<SampleType>& old, const BiquadCoefficients& replacements)
+{
+    jassert( old->coefficients.size() == (int)replacements.size() );
+    
+    auto* raw = old->getRawCoefficients();
+    for( size_t i = 0; i < replacements.size(); ++i )
+        raw[i] = (SampleType)replacements[i];
+}
+
+// gives every filter in the chain second order coefficients so that later updates never resize anything
+template<typename SampleType>
+void initialiseCoefficients(MonoChain<SampleType>& chain)
+{
+    auto initialise = [](Filter<SampleType>& filter)
+    {
+        *filter.coefficients = juce::dsp::IIR::Coefficients<SampleType>(1, 0, 0, 1, 0, 0);
+    };
+    
+    auto& lowCut = chain.template get<ChainPositions::LowCut>();
+    auto& highCut = chain.template get<ChainPositions::HighCut>();
+    
+    initialise(lowCut.template get<0>());
+    initialise(lowCut.template get<1>());
+    initialise(lowCut.template get<2>());
+    initialise(lowCut.template get<3>());
+    initialise(chain.template get<ChainPositions::Peak>());
+    initialise(highCut.template get<0>());
+    initialise(highCut.template get<1>());
+    initialise(highCut.template get<2>());
+    initialise(highCut.template get<3>());
+}
+
+/*
+ designs the filter coefficients on its own thread and hands finished sets to the audio thread
+ through a TripleBuffer, so parameter sweeps never add design cost to processBlock.
+ */
+struct CoefficientDesigner : juce::Thread
+{
+    CoefficientDesigner(const ChainParameters& params);
+    ~CoefficientDesigner() override;
+    
+    /*
+     designs every band for the new sample rate and publishes it straight away.
+     only call this while the thread is stopped, it becomes the producer for the duration.
+     */
+    void prepare(double sampleRate);
+    
+    // can be called from any thread, wakes the designer
+    void bandChanged(ChainPositions band);
+    void markAllBandsChanged();
+    
+    // audio thread only
+    bool pullLatestCoefficients() { return coefficientBuffer.update(); }
+    const FilterCoefficientSet& getLatestCoefficients() const { return coefficientBuffer.getReadBuffer(); }
+    
+    void run() override;
+private:
+    const ChainParameters& chainParameters;
+    double currentSampleRate = 44100.0;
+    
+    // the designer's own copy, so a band that didn't change doesn't have to be redesigned
+    FilterCoefficientSet current;
+    std::array<juce::Atomic<bool>, 3> changedBands;
+    
+    TripleBuffer<FilterCoefficientSet> coefficientBuffer;
+    
+    bool designChangedBands();
+    void publish();
+};
 
 template<int Index, typename ChainType, typename CoefficientType>
 void update(ChainType& chain, const CoefficientType& coefficients)
@@ -222,24 +563,51 @@ void updateCutFilter(ChainType& chain,
     }
 }
 
-inline auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
+template<typename SampleType>
+void applyCoefficients(MonoChain<SampleType>& chain, const FilterCoefficientSet& coefficientSet)
+{
+    chain.template setBypassed<ChainPositions::LowCut>(coefficientSet.lowCutBypassed);
+    chain.template setBypassed<ChainPositions::Peak>(coefficientSet.peakBypassed);
+    chain.template setBypassed<ChainPositions::HighCut>(coefficientSet.highCutBypassed);
+    
+    updateCutFilter(chain.template get<ChainPositions::LowCut>(), coefficientSet.lowCut, coefficientSet.lowCutSlope);
+    updateCoefficients(chain.template get<ChainPositions::Peak>().coefficients, coefficientSet.peak);
+    updateCutFilter(chain.template get<ChainPositions::HighCut>(), coefficientSet.highCut, coefficientSet.highCutSlope);
+}
+
+template<typename SampleType>
+auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
 {
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
-                                                                                       sampleRate,
-                                                                                       2*(chainSettings.lowCutSlope + 1));
+    return juce::dsp::FilterDesign<SampleType>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
+                                                                                            sampleRate,
+                                                                                            2*(chainSettings.lowCutSlope + 1));
 }
 
-inline auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
+template<typename SampleType>
+auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
 {
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
-                                                                                      sampleRate,
-                                                                                      2*(chainSettings.highCutSlope + 1));
+    return juce::dsp::FilterDesign<SampleType>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
+                                                                                           sampleRate,
+                                                                                           2*(chainSettings.highCutSlope + 1));
 }
 
+// set this to 1 to log runFilterBenchmark() results from prepareToPlay
+#ifndef SSIMPLEEQ_FILTER_BENCHMARK
+ #define SSIMPLEEQ_FILTER_BENCHMARK 0
+#endif
+
+/*
+ times ten seconds of stereo noise through every filter engine with all 9 stages switched on
+ (juce::dsp::IIR::Filter MonoChains in float and double vs. each BiquadCascade mode) and returns a report.
+ */
+juce::String runFilterBenchmark(double sampleRate, int blockSize);
+
 //==============================================================================
 /**
 */
-class SSimpleEQAudioProcessor  : public juce::AudioProcessor
+class SSimpleEQAudioProcessor  : public juce::AudioProcessor,
+                                 juce::AudioProcessorValueTreeState::Listener,
+                                 juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -255,6 +623,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    
+    // float runs the SIMD cascade, double runs a MonoChain<double> per channel
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -279,21 +651,67 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+    
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameterLayout()};
 
+    // "Filter Mode" picks one of these, in this order. it takes effect on the next block, float precision only
+    using FilterProcessingMode = BiquadCascade::ProcessingMode;
+    
     using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
+    // both analyzer channels, captured in one pass over each block
+    StereoSampleFifo<BlockType> analyzerFifo;
+    
+    /*
+     whatever displays the analyzer registers itself here for as long as it exists.
+     with nobody registered, or "Analyzer Enabled" off, processBlock doesn't capture anything at all.
+     */
+    void addAnalyzerConsumer() { ++numAnalyzerConsumers; }
+    void removeAnalyzerConsumer() { --numAnalyzerConsumers; }
     
 private:
     
-    MonoChain leftChain, rightChain;
-        
-    void updatePeakFilter(const ChainSettings& chainSettings);
-
-    void updateLowCutFilters(const ChainSettings& chainSettings);
-    void updateHighCutFilters(const ChainSettings& chainSettings);
+    BiquadCascade filterCascade;
+    std::atomic<float>* filterMode { apvts.getRawParameterValue("Filter Mode") };
+    
+    /*
+     "Processing Cores" set to multi-core splits the channel groups of the filter cascade across a few
+     worker threads, for layouts with lots of channels. blocks that are too small still run on the audio
+     thread alone. the workers only exist while it's on: the message thread starts and stops them,
+     holding workerPoolLock, and the audio thread only ever tries that lock and runs single threaded
+     for the block if it doesn't get it.
+     */
+    ChannelWorkerPool workerPool;
+    juce::SpinLock workerPoolLock;
+    std::atomic<float>* processingCores { apvts.getRawParameterValue("Processing Cores") };
+    
+    // how many tasks a block splits into with the current layout and precision, 0 while we're not prepared
+    std::atomic<int> numWorkerTasks { 0 };
+    
+    // message thread, or prepareToPlay/releaseResources
+    void updateWorkerPool();
+    void handleAsyncUpdate() override { updateWorkerPool(); }
+    
+    // below this many samples per block handing the channel groups out costs more than it saves
+    static constexpr int minSamplesForMultiCore = 64;
+    
+    // only filled in while the host has us running in double precision
+    std::vector<MonoChain<double>> doubleChains;
+    
+    template<typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+    
+    void processFilters(const juce::dsp::AudioBlock<float>& block);
+    void processFilters(const juce::dsp::AudioBlock<double>& block);
+    
+    std::atomic<int> numAnalyzerConsumers { 0 };
+    std::atomic<float>* analyzerEnabled { apvts.getRawParameterValue("Analyzer Enabled") };
+    // audio thread only, whether the last block was captured
+    bool analyzerWasCapturing = false;
+    
+    ChainParameters chainParameters { apvts };
+    CoefficientDesigner coefficientDesigner { chainParameters };
     
     void updateFilters();
     